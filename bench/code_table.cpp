@@ -0,0 +1,120 @@
+/* ---------------------------------------------------------------------- *
+ * code_table.cpp
+ *
+ * benchmark of the code table under the insertion pattern of the bfs.
+ * the codes of all flipped neighbors are recorded in the order in which
+ * the bfs produces them and are then inserted by 1 to 64 threads, both
+ * into a code table and into a map guarded by a mutex.
+ *
+ * the code table does not grow, so its capacity is the known number of
+ * triangulations and only n up to 18 is supported.
+ *
+ * usage: bench_code_table [-n vertices]
+ * ---------------------------------------------------------------------- */
+
+#include "../src/options.hpp"
+#include "../src/triangulation.hpp"
+#include "../src/code_batch.hpp"
+#include "../src/code_table.hpp"
+
+#include <vector>
+#include <string>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <iostream>
+
+// records the codes of all flipped neighbors in bfs order
+void record_codes(int n, long long capacity, std::vector<unsigned char>& stream, int& length) {
+    Code canonical = Code(Triangulation(n));
+    length = canonical.length();
+    CodeTable table(length, capacity);
+    bool inserted;
+    table.insert(canonical.symbols(), inserted);
+
+    CodeBatch batch;
+    std::vector<Edge*> edges;
+    std::vector<Code> codes;
+    for (int index = 0; index < table.size(); ++index) {
+        Triangulation triangulation(Code(table.code(index), length));
+        edges.clear();
+        for (int i = 0; i < triangulation.size(); ++i) {
+            Edge* edge = triangulation.edge(i);
+            if (triangulation.is_representative(edge) && triangulation.is_flippable(edge)) {
+                edges.push_back(edge);
+            }
+        }
+        batch.compute_codes(triangulation, edges, codes);
+        for (int i = 0; i < (int) codes.size(); ++i) {
+            stream.insert(stream.end(), codes[i].symbols(), codes[i].symbols() + length);
+            table.insert(codes[i].symbols(), inserted);
+        }
+    }
+}
+
+// inserts the recorded codes using the specified number of threads and
+// returns the elapsed time in seconds
+template <class Insert>
+double run(int threads, long long count, Insert insert) {
+    const long long chunk = 256;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&, t]() {
+            for (long long first = t * chunk; first < count; first += threads * chunk) {
+                long long last = std::min(count, first + chunk);
+                for (long long i = first; i < last; ++i) { insert(i); }
+            }
+        }));
+    }
+    for (int t = 0; t < threads; ++t) { workers[t].join(); }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int main(int argc, char* argv[]) {
+    char* option_n = get_cmd_option(argc, argv, "-n");
+    int n = (option_n) ? std::stoi(option_n) : 12;
+
+    long long capacity = triangulation_count(n);
+    if (n < 4 || capacity < 0) {
+        std::cerr << "the number of vertices must be between 4 and 18" << std::endl;
+        return 1;
+    }
+
+    std::vector<unsigned char> stream;
+    int length;
+    record_codes(n, capacity, stream, length);
+    long long count = (long long) stream.size() / length;
+    const unsigned char* symbols = stream.data();
+
+    std::cout << "n: " << n << ", insertions: " << count
+              << ", hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    std::cout << "threads\ttable Mops/s\tlocked map Mops/s" << std::endl;
+
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        CodeTable table(length, capacity);
+        double table_time = run(threads, count, [&](long long i) {
+            bool inserted;
+            table.insert(symbols + i * length, inserted);
+        });
+
+        std::map<Code, int> map;
+        std::mutex mutex;
+        double map_time = run(threads, count, [&](long long i) {
+            Code code(symbols + i * length, length);
+            std::lock_guard<std::mutex> lock(mutex);
+            map.insert(std::make_pair(code, (int) map.size()));
+        });
+
+        std::cout << threads << "\t" << count / table_time / 1e6
+                  << "\t" << count / map_time / 1e6 << std::endl;
+    }
+
+    return 0;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
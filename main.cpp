@@ -1,9 +1,17 @@
 #include "src/options.hpp"
 #include "src/flipgraph.hpp"
+#include "src/ordering.hpp"
+#include "src/functions.hpp"
+#include "src/reader.hpp"
+#include "src/parallel.hpp"
+#include "src/writer.hpp"
+#include "src/sharded.hpp"
+#include "src/labeled.hpp"
 
 #include <vector>
 #include <iostream>
 #include <fstream>
+#include <thread>
 
 const int default_n = 4;
 
@@ -12,19 +20,264 @@ int main(int argc, char* argv[]) {
     char* option_n = get_cmd_option(argc, argv, "-n");
     int n = (option_n) ? std::stoi(option_n) : default_n;
     
-    // option -o: output file
+    // option --resume: continue the search stopped at the specified checkpoint
+    char* option_resume = get_cmd_option(argc, argv, "--resume");
+    Checkpoint checkpoint;
+    if (option_resume) {
+        if (!read_checkpoint(option_resume, checkpoint)) {
+            std::cerr << "cannot read checkpoint: " << option_resume << std::endl;
+            return 1;
+        }
+        n = checkpoint.n;
+    }
+
+    // option -o: output file, which a resumed search appends to
     bool file_output = false;
     std::ofstream file_stream;
     char* option_o = get_cmd_option(argc, argv, "-o");
     if (option_o) {
         file_output = true;
-        file_stream.open(option_o);
+        std::ios::openmode mode = option_resume ? std::ios::app : std::ios::trunc;
+        file_stream.open(option_o, std::ios::out | std::ios::binary | mode);
     }
     std::ostream& output_stream = file_output ? file_stream : std::cout;
 
-    std::vector<std::vector<int> > graph;
-    compute_flip_graph(n, graph);
-    write_flip_graph(graph, output_stream);
+    // option -t: number of threads
+    char* option_t = get_cmd_option(argc, argv, "-t");
+    int threads = (option_t) ? std::stoi(option_t) : (int) std::thread::hardware_concurrency();
+    if (threads < 1) { threads = 1; }
+
+    // option -a: analyze the flip graph in the specified file
+    char* option_a = get_cmd_option(argc, argv, "-a");
+    if (option_a) {
+        CsrGraph graph;
+        if (!read_flip_graph(option_a, graph, threads)) {
+            std::cerr << "cannot read flip graph: " << option_a << std::endl;
+            return 1;
+        }
+        Scheduler scheduler(threads);
+        write_graph_analysis(graph, output_stream, scheduler);
+        if (file_output) { file_stream.close(); }
+        return 0;
+    }
+
+    // options --min-degree, --max-degree and --no-separating-triangles:
+    // restrict the flip graph to the accepted triangulations
+    PredicateList predicates;
+    char* option_min_degree = get_cmd_option(argc, argv, "--min-degree");
+    if (option_min_degree) { predicates.add(new MinDegreePredicate(std::stoi(option_min_degree))); }
+    char* option_max_degree = get_cmd_option(argc, argv, "--max-degree");
+    if (option_max_degree) { predicates.add(new MaxDegreePredicate(std::stoi(option_max_degree))); }
+    if (cmd_option_exists(argc, argv, "--no-separating-triangles")) {
+        predicates.add(new SeparatingTrianglePredicate());
+    }
+    const Predicate* predicate = predicates.empty() ? 0 : &predicates;
+
+    // a restricted search starts from an accepted triangulation that is
+    // found by random flips
+    if (predicate && !predicate->admits(n)) {
+        std::cerr << "no triangulation with " << n << " vertices is accepted" << std::endl;
+        return 1;
+    }
+
+    // options --labeled and --fixed-outer: compute the flip graph on labeled
+    // triangulations, optionally with the outer triangle 0, 1, 2 fixed
+    bool fixed_outer = cmd_option_exists(argc, argv, "--fixed-outer");
+    bool labeled = fixed_outer || cmd_option_exists(argc, argv, "--labeled");
+    if (labeled && (predicate || option_resume || cmd_option_exists(argc, argv, "-s"))) {
+        std::cerr << "a labeled flip graph cannot be restricted, resumed or summarized" << std::endl;
+        return 1;
+    }
+    bool budgeted = cmd_option_exists(argc, argv, "--max-memory") || cmd_option_exists(argc, argv, "--checkpoint");
+    if (labeled && ((option_t && threads > 1) || cmd_option_exists(argc, argv, "--numa") || budgeted)) {
+        std::cerr << "a labeled flip graph is computed on one thread without shards or a memory budget" << std::endl;
+        return 1;
+    }
+
+    // option -s: only compute statistics of the flip graph
+    if (cmd_option_exists(argc, argv, "-s")) {
+        FlipGraphStatistics statistics;
+        Scheduler scheduler(threads);
+        if (threads == 1 || !compute_flip_graph_statistics_parallel(n, scheduler, statistics, predicate)) {
+            compute_flip_graph_statistics(n, statistics, predicate);
+        }
+        write_statistics(statistics, output_stream);
+        if (file_output) { file_stream.close(); }
+        if (statistics.vertices == 0) {
+            std::cerr << "no accepted triangulation with " << n << " vertices was found" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // option -r: vertex order of the output
+    VertexOrder vertex_order = ORDER_DISCOVERY;
+    char* option_r = get_cmd_option(argc, argv, "-r");
+    if (option_r && !parse_vertex_order(option_r, vertex_order)) {
+        std::cerr << "unknown vertex order: " << option_r << std::endl;
+        return 1;
+    }
+
+    // option -p: output file of the codes of the vertices in the output order
+    char* option_p = get_cmd_option(argc, argv, "-p");
+
+    // option -f: output format
+    GraphFormat format = FORMAT_TEXT;
+    char* option_f = get_cmd_option(argc, argv, "-f");
+    if (option_f && !parse_graph_format(option_f, format)) {
+        std::cerr << "unknown format: " << option_f << std::endl;
+        return 1;
+    }
+
+    // option -z: compress the output
+    bool compress = cmd_option_exists(argc, argv, "-z");
+
+    // option -v: write progress and statistics of the writer and the scheduler
+    bool verbose = cmd_option_exists(argc, argv, "-v");
+
+    // option --max-memory: memory budget of the search
+    MemoryBudget budget;
+    char* option_m = get_cmd_option(argc, argv, "--max-memory");
+    if (option_m && !parse_memory_size(option_m, budget.limit)) {
+        std::cerr << "invalid memory size: " << option_m << std::endl;
+        return 1;
+    }
+    if (verbose) { budget.progress = &std::cerr; }
+    if (option_m && option_t && threads > 1) {
+        std::cerr << "the memory budget is only enforced by the sequential search, using one thread" << std::endl;
+    }
+    if (option_resume && budget.limit > 0 && checkpoint_memory(checkpoint) > budget.limit) {
+        std::cerr << "the checkpoint alone exceeds the memory budget" << std::endl;
+        return 1;
+    }
+
+    // option --checkpoint: file the checkpoint is written to
+    char* option_c = get_cmd_option(argc, argv, "--checkpoint");
+    if (option_c) { budget.checkpoint = option_c; }
+
+    // option --numa: shard the search across numa nodes
+    bool numa = cmd_option_exists(argc, argv, "--numa");
+    ShardStatistics shard_statistics;
+    if (numa && predicate) {
+        std::cerr << "a sharded search cannot be restricted" << std::endl;
+        return 1;
+    }
+
+    // only the streamed output can be continued
+    if (option_resume && vertex_order != ORDER_DISCOVERY) {
+        std::cerr << "a resumed search requires the discovery order" << std::endl;
+        return 1;
+    }
+    if (option_m && vertex_order != ORDER_DISCOVERY) {
+        std::cerr << "a memory budget requires the discovery order" << std::endl;
+        return 1;
+    }
+
+    std::vector<int> order;
+    std::vector<unsigned char> codes;
+    Scheduler scheduler(threads);
+    GraphWriter writer(output_stream, format, compress, !option_resume);
+
+    // only the generic search enforces a budget, the parallel search
+    // accounts its memory
+    // the fixed and the sharded engines explore all triangulations
+    // an engine that fails falls back to the next one unless it already
+    // passed vertices to the builder, which cannot be taken back
+    bool failed = false;
+    auto explore = [&](GraphBuilder& builder) {
+        if (labeled) {
+            compute_labeled_flip_graph(n, fixed_outer, builder, order);
+            return true;
+        }
+        if (option_resume) { return resume_flip_graph(checkpoint, builder, order, budget, predicate); }
+        if (option_m) { return compute_flip_graph(n, builder, order, budget, predicate); }
+        int first = builder.count();
+        if (numa) {
+            if (compute_flip_graph_sharded(n, threads, builder, order, shard_statistics)) { return true; }
+            if (builder.count() != first) { failed = true; return false; }
+        }
+        if (threads > 1) {
+            if (compute_flip_graph_parallel(n, scheduler, builder, order, predicate, &budget)) { return true; }
+            if (builder.count() != first) { failed = true; return false; }
+        }
+        if (!predicate) {
+            if (compute_fixed_flip_graph(n, builder, order)) { return true; }
+            if (builder.count() != first) { failed = true; return false; }
+        }
+        return compute_flip_graph(n, builder, order, budget, predicate);
+    };
+
+    bool complete;
+    if (vertex_order == ORDER_DISCOVERY) {
+        // vertices are written while the flip graph is explored
+        GraphBuilder builder(writer, option_resume ? checkpoint.next : 0);
+        if (option_p) { builder.record_codes(codes); }
+        complete = explore(builder);
+        order.clear();
+        for (int i = 0; i < builder.count(); ++i) { order.push_back(i); }
+    } else {
+        CsrGraph graph;
+        GraphBuilder builder(graph);
+        if (option_p) { builder.record_codes(codes); }
+        complete = explore(builder);
+
+        // a partial graph refers to vertices it does not contain
+        if (complete) {
+            if (vertex_order != ORDER_CODE) { order.clear(); }
+            if (vertex_order == ORDER_RCM) { compute_rcm_order(graph, order); }
+            if (vertex_order == ORDER_DEGREE) { compute_degree_order(graph, order); }
+
+            CsrGraph relabeled;
+            relabel_graph(graph, order, relabeled);
+            write_flip_graph(relabeled, writer);
+        }
+    }
+    bool written = writer.finish();
+
+    if (verbose) {
+        write_writer_statistics(writer.statistics(), std::cerr);
+        write_scheduler_statistics(scheduler.statistics(), std::cerr);
+        if (numa) { write_shard_statistics(shard_statistics, std::cerr); }
+        if (budget.peak.total() > 0) {
+            std::cerr << "peak ";
+            write_memory_usage(budget.peak, std::cerr);
+        }
+    }
+
+    if (!written) {
+        std::cerr << "cannot write the flip graph" << std::endl;
+        if (file_output) { file_stream.close(); }
+        return 1;
+    }
+
+    if (failed) {
+        std::cerr << "the search failed after part of the flip graph was built" << std::endl;
+        if (file_output) { file_stream.close(); }
+        return 1;
+    }
+
+    if (complete && order.empty()) {
+        std::cerr << "no accepted triangulation with " << n << " vertices was found" << std::endl;
+        if (file_output) { file_stream.close(); }
+        return 1;
+    }
+
+    if (!complete && !budget.checkpointed) {
+        std::cerr << "memory budget exceeded, cannot write checkpoint to " << budget.checkpoint << std::endl;
+        if (file_output) { file_stream.close(); }
+        return 1;
+    }
+
+    if (!complete) {
+        std::cerr << "memory budget exceeded, checkpoint written to " << budget.checkpoint << std::endl;
+        if (file_output) { file_stream.close(); }
+        return 1;
+    }
+
+    if (option_p) {
+        std::ofstream order_stream(option_p);
+        write_order(order, codes, 7 * n - 11, order_stream);
+    }
 
     // close output stream
     if (file_output) { file_stream.close(); }
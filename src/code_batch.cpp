@@ -0,0 +1,118 @@
+/* ---------------------------------------------------------------------- *
+ * code_batch.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "code_batch.hpp"
+
+#include <algorithm>
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the code batch class
+ * ---------------------------------------------------------------------- */
+
+CodeBatch::CodeBatch() : n_(0), m_(0) {}
+
+void CodeBatch::load(const Triangulation& triangulation) {
+    n_ = triangulation.order();
+    m_ = triangulation.size();
+    target_.resize(m_);
+    twin_.resize(m_);
+    next_.resize(m_);
+    labels_.resize(n_);
+    queue_.resize(n_);
+    code_.resize(n_ + m_ + 1);
+
+    for (int i = 0; i < m_; ++i) {
+        Edge* edge = triangulation.edge(i);
+        target_[i] = edge->target()->index();
+        twin_[i] = edge->twin()->index();
+        next_[i] = edge->next()->index();
+    }
+}
+
+void CodeBatch::flip(int edge) {
+    int twin = twin_[edge];
+    int edge_ta = next_[edge];
+    int edge_as = next_[edge_ta];
+    int edge_sb = next_[twin];
+    int edge_bt = next_[edge_sb];
+
+    next_[edge] = edge_bt;
+    next_[edge_bt] = edge_ta;
+    next_[edge_ta] = edge;
+    next_[twin] = edge_as;
+    next_[edge_as] = edge_sb;
+    next_[edge_sb] = twin;
+    target_[edge] = target_[edge_sb];
+    target_[twin] = target_[edge_ta];
+}
+
+void CodeBatch::update(int edge, bool clockwise) {
+    std::fill(labels_.begin(), labels_.end(), 0);
+
+    int head = 0;
+    int tail = 0;
+    int index = 1;
+    int label = 1;
+    bool smaller = false;
+
+    // breadth first search
+    labels_[target_[edge]] = label++;
+    queue_[tail++] = edge;
+    while (head < tail) {
+        int first = twin_[queue_[head++]];
+        int current = first;
+
+        do {
+            int vertex = target_[current];
+            if (labels_[vertex] == 0) {
+                labels_[vertex] = label++;
+                queue_[tail++] = current;
+            }
+
+            int symbol = labels_[vertex];
+            if (smaller) {
+                code_[index] = symbol;
+            } else if (symbol < code_[index]) {
+                smaller = true;
+                code_[index] = symbol;
+            } else if (symbol > code_[index]) {
+                return;
+            }
+
+            index++;
+            current = clockwise ? next_[twin_[current]] : twin_[next_[next_[current]]];
+        } while (current != first);
+
+        // mark end of current vertex's phase
+        if (code_[index] > 0) { smaller = true; }
+        code_[index++] = 0;
+    }
+}
+
+void CodeBatch::compute_codes(const Triangulation& triangulation, const std::vector<Edge*>& edges,
+                              std::vector<Code>& codes) {
+    load(triangulation);
+    codes.clear();
+    codes.reserve(edges.size());
+
+    int k = (int) edges.size();
+    for (int i = 0; i < k; ++i) {
+        int edge = edges[i]->index();
+        flip(edge);
+
+        std::fill(code_.begin(), code_.end(), (unsigned char) n_);
+        for (int j = 0; j < m_; ++j) {
+            update(j, true);
+            update(j, false);
+        }
+        codes.push_back(Code(code_.data(), (int) code_.size()));
+
+        // note: after two flips the edge and its twin are swapped
+        flip(edge);
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
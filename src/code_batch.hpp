@@ -0,0 +1,73 @@
+/* ---------------------------------------------------------------------- *
+ * code_batch.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_CODE_BATCH__
+#define __FG_CODE_BATCH__
+
+#include "triangulation.hpp"
+
+#include <vector>
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the code batch class
+ *
+ * computes the codes of all triangulations obtained from one triangulation
+ * by flipping one of a list of edges. the triangulation is copied once into
+ * flat arrays of edge indices, the flips are applied to that copy and all
+ * codes are computed using the same scratch buffers. the triangulation
+ * itself, including the labels of its vertices, is not modified.
+ * ---------------------------------------------------------------------- */
+
+class CodeBatch {
+public:
+    // constructor that builds an empty batch
+    CodeBatch();
+
+private:
+    // the number of vertices
+    int n_;
+
+    // the number of edges
+    int m_;
+
+    // the target vertex of every edge
+    std::vector<int> target_;
+
+    // the twin of every edge
+    std::vector<int> twin_;
+
+    // the next edge of the incident face of every edge
+    std::vector<int> next_;
+
+    // the label of every vertex
+    std::vector<int> labels_;
+
+    // the bfs queue of edges
+    std::vector<int> queue_;
+
+    // the symbols of the code being computed
+    std::vector<unsigned char> code_;
+
+    // copies the specified triangulation into the flat arrays
+    void load(const Triangulation& triangulation);
+
+    // flips the specified edge of the flat copy
+    void flip(int edge);
+
+    // updates the code for the flat copy starting at the specified edge
+    // and using the specified orientation
+    void update(int edge, bool clockwise);
+
+public:
+    // computes the codes of the triangulations obtained by flipping each
+    // of the specified edges of the specified triangulation
+    void compute_codes(const Triangulation& triangulation, const std::vector<Edge*>& edges,
+                       std::vector<Code>& codes);
+};
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
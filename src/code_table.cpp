@@ -0,0 +1,182 @@
+/* ---------------------------------------------------------------------- *
+ * code_table.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "code_table.hpp"
+
+#include <cassert>
+#include <cstring>
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the code table class
+ * ---------------------------------------------------------------------- */
+
+CodeTable::CodeTable(int length, long long capacity) {
+    assert(capacity > 0);
+    length_ = length;
+    capacity_ = capacity;
+
+    // keep the load factor of the table below one half
+    uint64_t slots = 1024;
+    while (slots < 2 * (uint64_t) capacity) { slots *= 2; }
+    mask_ = slots - 1;
+
+    // leave room for codes that lost a race against an equal code
+    arena_capacity_ = capacity + capacity / 16 + 1024;
+    arena_size_.store(0);
+    size_.store(0);
+
+    slots_ = new std::atomic<uint64_t>[slots];
+    arena_ = new unsigned char[arena_capacity_ * length_];
+    indices_ = new std::atomic<int>[arena_capacity_];
+    positions_ = new std::atomic<uint32_t>[arena_capacity_];
+    for (uint64_t i = 0; i < slots; ++i) { slots_[i].store(0, std::memory_order_relaxed); }
+    for (long long i = 0; i < arena_capacity_; ++i) {
+        indices_[i].store(-1, std::memory_order_relaxed);
+        positions_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+CodeTable::~CodeTable() {
+    delete[] slots_;
+    delete[] arena_;
+    delete[] indices_;
+    delete[] positions_;
+}
+
+uint64_t CodeTable::hash(const unsigned char* symbols) const {
+    // fnv-1a followed by the finalizer of splitmix64
+    uint64_t h = 14695981039346656037ull;
+    for (int i = 0; i < length_; ++i) {
+        h ^= symbols[i];
+        h *= 1099511628211ull;
+    }
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return h;
+}
+
+int CodeTable::publish(uint32_t position) {
+    while (true) {
+        // entries below the size already have their index assigned
+        int size = size_.load();
+        int index = indices_[position].load();
+        if (index >= 0) { return index; }
+
+        // claim the next entry of the log unless another code holds it
+        uint32_t entry = 0;
+        positions_[size].compare_exchange_strong(entry, position + 1);
+        entry = positions_[size].load();
+
+        // complete the entry on behalf of whichever code claimed it
+        int unknown = -1;
+        indices_[entry - 1].compare_exchange_strong(unknown, size);
+        size_.compare_exchange_strong(size, size + 1);
+    }
+}
+
+int CodeTable::insert(const unsigned char* symbols, bool& inserted) {
+    const uint32_t none = 0xffffffffu;
+    uint64_t h = hash(symbols);
+    uint64_t fingerprint = h >> 32;
+    uint32_t position = none;
+    inserted = false;
+
+    uint64_t slot = h & mask_;
+    for (uint64_t probe = 0; probe <= mask_; ++probe) {
+        uint64_t value = slots_[slot].load(std::memory_order_acquire);
+
+        if (value == 0) {
+            // copy code to the arena before it is published
+            if (position == none) {
+                long long allocated = arena_size_.fetch_add(1);
+                if (allocated >= arena_capacity_) { return -1; }
+                position = (uint32_t) allocated;
+                std::memcpy(arena_ + (long long) position * length_, symbols, length_);
+            }
+
+            uint64_t desired = (fingerprint << 32) | (uint64_t) (position + 1);
+            if (slots_[slot].compare_exchange_strong(value, desired,
+                                                     std::memory_order_acq_rel,
+                                                     std::memory_order_acquire)) {
+                inserted = true;
+                return publish(position);
+            }
+            // another thread claimed the slot, value now holds its content
+        }
+
+        if ((value >> 32) == fingerprint) {
+            uint32_t other = (uint32_t) (value & 0xffffffffu) - 1;
+            if (std::memcmp(arena_ + (long long) other * length_, symbols, length_) == 0) {
+                return publish(other);
+            }
+        }
+
+        slot = (slot + 1) & mask_;
+    }
+
+    return -1;
+}
+
+int CodeTable::find(const unsigned char* symbols) {
+    uint64_t h = hash(symbols);
+    uint64_t fingerprint = h >> 32;
+
+    uint64_t slot = h & mask_;
+    for (uint64_t probe = 0; probe <= mask_; ++probe) {
+        uint64_t value = slots_[slot].load(std::memory_order_acquire);
+        if (value == 0) { return -1; }
+        if ((value >> 32) == fingerprint) {
+            uint32_t other = (uint32_t) (value & 0xffffffffu) - 1;
+            if (std::memcmp(arena_ + (long long) other * length_, symbols, length_) == 0) {
+                return publish(other);
+            }
+        }
+        slot = (slot + 1) & mask_;
+    }
+
+    return -1;
+}
+
+const unsigned char* CodeTable::code(int index) const {
+    uint32_t position = positions_[index].load(std::memory_order_acquire) - 1;
+    return arena_ + (long long) position * length_;
+}
+
+int CodeTable::length() const {
+    return length_;
+}
+
+int CodeTable::size() const {
+    return size_.load();
+}
+
+long long CodeTable::capacity() const {
+    return capacity_;
+}
+
+long long CodeTable::memory() const {
+    return (long long) (mask_ + 1) * sizeof(uint64_t)
+         + arena_capacity_ * (length_ + sizeof(int) + sizeof(uint32_t));
+}
+
+/* ---------------------------------------------------------------------- *
+ * functions
+ * ---------------------------------------------------------------------- */
+
+long long triangulation_count(int n) {
+    // number of triangulations with n vertices, sequence a000109 of the oeis
+    static const long long counts[] = {
+        1, 1, 1, 2, 5, 14, 50, 233, 1249, 7595, 49566, 339722, 2406841,
+        17490241, 129664753, 977526957
+    };
+    if (n < 3 || n > 18) { return -1; }
+    return counts[n - 3];
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,120 @@
+/* ---------------------------------------------------------------------- *
+ * code_table.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_CODE_TABLE__
+#define __FG_CODE_TABLE__
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the code table class
+ *
+ * a lock-free hash map from codes of equal length to consecutive indices
+ * that may be used by any number of threads at once.
+ *
+ * the symbols of every code are appended to an arena. the table itself is
+ * an array of 64-bit slots with linear probing. a slot holds a 32-bit
+ * fingerprint of the code and the position of the code in the arena, and
+ * is claimed by a single compare-and-swap. codes are never removed.
+ *
+ * indices are assigned in the order of a log that maps every index to an
+ * arena position. a thread that finds a claimed code without an index does
+ * not wait for the thread that claimed it but helps to append the code to
+ * the log, so no thread ever waits for another.
+ *
+ * the table does not grow. its capacity is fixed on construction, for
+ * instance from the known number of triangulations. insertions into a full
+ * table fail.
+ * ---------------------------------------------------------------------- */
+
+class CodeTable {
+public:
+    // constructor that builds a table for the specified positive number of
+    // codes with the specified length
+    CodeTable(int length, long long capacity);
+
+    // destructor
+    ~CodeTable();
+
+private:
+    // the length of every code
+    int length_;
+
+    // the maximum number of codes
+    long long capacity_;
+
+    // the number of slots minus one
+    uint64_t mask_;
+
+    // the slots of the hash table
+    std::atomic<uint64_t>* slots_;
+
+    // the symbols of all codes, including codes that lost a race
+    unsigned char* arena_;
+
+    // the size of the arena in codes
+    long long arena_capacity_;
+
+    // the number of codes allocated in the arena
+    std::atomic<long long> arena_size_;
+
+    // the index of the code at every arena position or -1 if not yet known
+    std::atomic<int>* indices_;
+
+    // the log of arena positions plus one for every index or zero if the
+    // entry is not yet claimed
+    std::atomic<uint32_t>* positions_;
+
+    // the number of codes in the table whose index is assigned
+    std::atomic<int> size_;
+
+    // returns the hash of the specified symbols
+    uint64_t hash(const unsigned char* symbols) const;
+
+    // returns the index of the code at the specified arena position and
+    // assigns it first if necessary
+    int publish(uint32_t position);
+
+    // copies the table so copies are not possible
+    CodeTable(const CodeTable& table);
+
+public:
+    // inserts the specified code unless it is already present. returns the
+    // index of the code or -1 if the table is full, and sets inserted to
+    // whether the code was added by this call
+    int insert(const unsigned char* symbols, bool& inserted);
+
+    // returns the index of the specified code or -1 if it is not present
+    int find(const unsigned char* symbols);
+
+    // returns the symbols of the code with the specified index
+    const unsigned char* code(int index) const;
+
+    // returns the length of every code
+    int length() const;
+
+    // returns the number of codes in the table
+    int size() const;
+
+    // returns the maximum number of codes
+    long long capacity() const;
+
+    // returns the number of bytes allocated by the table
+    long long memory() const;
+};
+
+/* ---------------------------------------------------------------------- *
+ * function declarations
+ * ---------------------------------------------------------------------- */
+
+// returns the number of triangulations with n vertices or -1 if unknown
+long long triangulation_count(int n);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,202 @@
+/* ---------------------------------------------------------------------- *
+ * compression.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "compression.hpp"
+
+#include <cstring>
+#include <cstdint>
+#include <climits>
+
+/* ---------------------------------------------------------------------- *
+ * helper functions
+ * ---------------------------------------------------------------------- */
+
+namespace {
+
+// the minimum length of a match
+const int min_match = 4;
+
+// the maximum distance of a match
+const int max_offset = 65535;
+
+// the number of bits of the hash of four bytes
+const int hash_bits = 14;
+
+// returns the four bytes at the specified position
+inline uint32_t read_four(const char* p) {
+    uint32_t value;
+    std::memcpy(&value, p, 4);
+    return value;
+}
+
+// returns the hash of the four bytes at the specified position
+inline uint32_t hash_four(const char* p) {
+    return (read_four(p) * 2654435761u) >> (32 - hash_bits);
+}
+
+// appends the specified length extension
+void write_length(int length, std::vector<char>& output) {
+    while (length >= 255) {
+        output.push_back((char) 255);
+        length -= 255;
+    }
+    output.push_back((char) length);
+}
+
+// reads a length extension. returns false if the input ends or the length
+// exceeds the specified limit, which keeps it from overflowing
+bool read_length(const unsigned char*& p, const unsigned char* end, int limit, int& length) {
+    unsigned char byte;
+    do {
+        if (p == end) { return false; }
+        byte = *p++;
+        length += byte;
+        if (length > limit) { return false; }
+    } while (byte == 255);
+    return true;
+}
+
+// appends the specified 32-bit integer in little-endian order
+void write_uint32(uint32_t value, std::vector<char>& output) {
+    for (int i = 0; i < 4; ++i) { output.push_back((char) ((value >> (8 * i)) & 0xff)); }
+}
+
+// returns the 32-bit little-endian integer at the specified position
+uint32_t read_uint32(const char* p) {
+    const unsigned char* q = (const unsigned char*) p;
+    return (uint32_t) q[0] | ((uint32_t) q[1] << 8) | ((uint32_t) q[2] << 16) | ((uint32_t) q[3] << 24);
+}
+
+// appends a sequence of the specified literals and match
+void write_sequence(const char* literals, int literal_length, int offset, int match_length,
+                    std::vector<char>& output) {
+    int literal_code = literal_length < 15 ? literal_length : 15;
+    int match_code = 0;
+    if (match_length > 0) { match_code = match_length - min_match < 15 ? match_length - min_match : 15; }
+
+    output.push_back((char) ((literal_code << 4) | match_code));
+    if (literal_code == 15) { write_length(literal_length - 15, output); }
+    output.insert(output.end(), literals, literals + literal_length);
+
+    if (match_length > 0) {
+        output.push_back((char) (offset & 0xff));
+        output.push_back((char) (offset >> 8));
+        if (match_code == 15) { write_length(match_length - min_match - 15, output); }
+    }
+}
+
+}
+
+/* ---------------------------------------------------------------------- *
+ * block compression
+ * ---------------------------------------------------------------------- */
+
+void compress_block(const char* block, int size, std::vector<char>& compressed) {
+    std::vector<int> table(1 << hash_bits, -1);
+    int anchor = 0;
+    int position = 0;
+
+    // greedy parsing, matches are not searched in the last bytes
+    while (position + min_match <= size) {
+        uint32_t hash = hash_four(block + position);
+        int candidate = table[hash];
+        table[hash] = position;
+
+        if (candidate < 0 || position - candidate > max_offset
+            || read_four(block + candidate) != read_four(block + position)) {
+            position++;
+            continue;
+        }
+
+        int length = min_match;
+        while (position + length < size && block[candidate + length] == block[position + length]) {
+            length++;
+        }
+
+        write_sequence(block + anchor, position - anchor, position - candidate, length, compressed);
+        position += length;
+        anchor = position;
+    }
+
+    write_sequence(block + anchor, size - anchor, 0, 0, compressed);
+}
+
+bool decompress_block(const char* compressed, int size, char* block, int block_size) {
+    const unsigned char* p = (const unsigned char*) compressed;
+    const unsigned char* end = p + size;
+    int position = 0;
+
+    while (p != end) {
+        int token = *p++;
+
+        // literals
+        int literal_length = token >> 4;
+        if (literal_length == 15 && !read_length(p, end, block_size, literal_length)) { return false; }
+        if (end - p < literal_length || block_size - position < literal_length) { return false; }
+        std::memcpy(block + position, p, literal_length);
+        p += literal_length;
+        position += literal_length;
+
+        // the last sequence has no match
+        if (p == end) { break; }
+
+        // match
+        if (end - p < 2) { return false; }
+        int offset = p[0] | (p[1] << 8);
+        p += 2;
+        int match_length = token & 15;
+        if (match_length == 15 && !read_length(p, end, block_size, match_length)) { return false; }
+        match_length += min_match;
+        if (offset == 0 || offset > position || block_size - position < match_length) { return false; }
+
+        // matches may overlap their own output
+        for (int i = 0; i < match_length; ++i) {
+            block[position + i] = block[position - offset + i];
+        }
+        position += match_length;
+    }
+
+    return position == block_size;
+}
+
+/* ---------------------------------------------------------------------- *
+ * streams
+ * ---------------------------------------------------------------------- */
+
+void compress_frame(const char* block, int size, std::vector<char>& compressed) {
+    size_t header = compressed.size();
+    write_uint32((uint32_t) size, compressed);
+    write_uint32(0, compressed);
+    compress_block(block, size, compressed);
+
+    uint32_t compressed_size = (uint32_t) (compressed.size() - header - 8);
+    for (int i = 0; i < 4; ++i) {
+        compressed[header + 4 + i] = (char) ((compressed_size >> (8 * i)) & 0xff);
+    }
+}
+
+bool decompress_stream(const char* compressed, long long size, std::vector<char>& stream) {
+    long long position = 0;
+    while (position < size) {
+        if (size - position < 8) { return false; }
+        uint32_t block_size = read_uint32(compressed + position);
+        uint32_t compressed_size = read_uint32(compressed + position + 4);
+        position += 8;
+        if ((unsigned long long) (size - position) < compressed_size) { return false; }
+        if (block_size > INT_MAX || compressed_size > INT_MAX) { return false; }
+
+        size_t offset = stream.size();
+        stream.resize(offset + block_size);
+        if (!decompress_block(compressed + position, (int) compressed_size,
+                              stream.data() + offset, (int) block_size)) {
+            return false;
+        }
+        position += compressed_size;
+    }
+    return true;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
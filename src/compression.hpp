@@ -0,0 +1,48 @@
+/* ---------------------------------------------------------------------- *
+ * compression.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_COMPRESSION__
+#define __FG_COMPRESSION__
+
+#include <vector>
+
+/* ---------------------------------------------------------------------- *
+ * lz block compression
+ *
+ * a block is compressed into a sequence of literal runs and back
+ * references into the previous 64 KiB of the block, similar to lz4. every
+ * sequence starts with a token whose upper four bits hold the number of
+ * literals and whose lower four bits hold the match length minus four. a
+ * value of 15 is followed by extension bytes that are added until a byte
+ * other than 255 is found. the literals follow, then the two-byte offset
+ * of the match and the extension of the match length. the last sequence of
+ * a block consists of literals only.
+ *
+ * a compressed stream consists of the magic "FGZ1" followed by frames,
+ * each holding the uncompressed and the compressed size of a block as
+ * 32-bit little-endian integers and the compressed block.
+ * ---------------------------------------------------------------------- */
+
+// the magic of a compressed stream
+const char compression_magic[] = "FGZ1";
+
+// appends the compressed form of the specified block to the specified vector
+void compress_block(const char* block, int size, std::vector<char>& compressed);
+
+// decompresses the specified block into the specified buffer of the specified
+// size. returns false if the block is malformed or does not have that size
+bool decompress_block(const char* compressed, int size, char* block, int block_size);
+
+// appends a frame holding the specified block to the specified vector
+void compress_frame(const char* block, int size, std::vector<char>& compressed);
+
+// decompresses the specified stream without its magic. returns false if the
+// stream is malformed
+bool decompress_stream(const char* compressed, long long size, std::vector<char>& stream);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,307 @@
+/* ---------------------------------------------------------------------- *
+ * fixed_triangulation.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_FIXED_TRIANGULATION__
+#define __FG_FIXED_TRIANGULATION__
+
+#include <array>
+#include <cstring>
+
+// the largest number of vertices handled by the fixed size classes
+const int max_fixed_order = 12;
+
+/* ---------------------------------------------------------------------- *
+ * forward declarations
+ * ---------------------------------------------------------------------- */
+
+template <int N> class FixedTriangulation;
+template <int N> class FixedCode;
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the fixed triangulation class
+ *
+ * a triangulation with N vertices whose half-edges are stored in arrays
+ * of compile-time size. half-edges are identified by their index and the
+ * edges 2k and 2k + 1 are twins. since every face is a triangle, the
+ * previous edge of a face is the next edge of the next edge. in addition,
+ * the neighbors of every vertex are kept as a bit set.
+ * ---------------------------------------------------------------------- */
+
+template <int N>
+class FixedTriangulation {
+public:
+    // the number of vertices
+    static const int ORDER = N;
+
+    // the number of half-edges
+    static const int SIZE = 6 * N - 12;
+
+    // constructor that builds a canonical triangulation with N vertices
+    FixedTriangulation();
+
+private:
+    // the target vertex of every edge
+    std::array<unsigned char, SIZE> target_;
+
+    // the next edge of the incident face of every edge
+    std::array<unsigned char, SIZE> next_;
+
+    // an outgoing edge of every vertex
+    std::array<unsigned char, N> edge_;
+
+    // the neighbors of every vertex as a bit set
+    std::array<unsigned int, N> adjacency_;
+
+    // creates a new pair of twins and returns the first of them
+    int new_twins(int& count);
+
+    // builds a triangle with the three specified edges and vertices
+    void make_triangle(int edge_a, int edge_b, int edge_c,
+                       int vertex_a, int vertex_b, int vertex_c);
+
+    // performs an e3-expansion at the specified edge
+    void expand_three(int edge, int vertex, int& count);
+
+public:
+    // returns the number of vertices
+    int order() const { return N; }
+
+    // returns the number of edges
+    int size() const { return SIZE; }
+
+    // returns an outgoing edge of the specified vertex
+    int edge(int vertex) const { return edge_[vertex]; }
+
+    // returns the target vertex of the specified edge
+    int target(int edge) const { return target_[edge]; }
+
+    // returns the twin of the specified edge
+    int twin(int edge) const { return edge ^ 1; }
+
+    // returns the previous edge of the incident face of the specified edge
+    int prev(int edge) const { return next_[next_[edge]]; }
+
+    // returns the next edge of the incident face of the specified edge
+    int next(int edge) const { return next_[edge]; }
+
+    // returns whether the specified edge or its twin is representative
+    bool is_representative(int edge) const { return (edge & 1) == 0; }
+
+    // returns whether the specified edge is flippable or not
+    bool is_flippable(int edge) const;
+
+    // flips the specified edge
+    void flip(int edge);
+};
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the fixed code class
+ *
+ * the code of a triangulation with N vertices. codes are identical to the
+ * ones computed by the code class but are stored in an array of
+ * compile-time size.
+ * ---------------------------------------------------------------------- */
+
+template <int N>
+class FixedCode {
+public:
+    // the length of the code
+    static const int LENGTH = N + FixedTriangulation<N>::SIZE + 1;
+
+    // constructor that computes code from the specified triangulation
+    FixedCode(const FixedTriangulation<N>& triangulation);
+
+private:
+    // the symbols of the code
+    std::array<unsigned char, LENGTH> code_;
+
+    // updates the this code for the specified triangulation starting at
+    // the specified edge and using the specified orientation.
+    // the code is updated if the new code is lexicographically smaller
+    void update(const FixedTriangulation<N>& triangulation, int edge, bool clockwise);
+
+public:
+    // returns the i-th symbol of the code
+    unsigned char symbol(int i) const { return code_[i]; }
+
+    // returns the array of symbols of the code
+    const unsigned char* symbols() const { return code_.data(); }
+
+    // returns the length of the code
+    int length() const { return LENGTH; }
+
+    // returns whether the code is equal to the specified code or not
+    bool operator ==(const FixedCode& other) const {
+        return std::memcmp(code_.data(), other.code_.data(), LENGTH) == 0;
+    }
+
+    // returns whether the code lexicographically smaller than the specified
+    // code or not
+    bool operator <(const FixedCode& other) const {
+        return std::memcmp(code_.data(), other.code_.data(), LENGTH) < 0;
+    }
+};
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the fixed triangulation class
+ * ---------------------------------------------------------------------- */
+
+template <int N>
+FixedTriangulation<N>::FixedTriangulation() {
+    int count = 0;
+    adjacency_.fill(0);
+
+    // build first triangle
+    int edge_ab = new_twins(count);
+    int edge_bc = new_twins(count);
+    int edge_ca = new_twins(count);
+    make_triangle(edge_ab, edge_bc, edge_ca, 2, 0, 1);
+    make_triangle(twin(edge_ca), twin(edge_bc), twin(edge_ab), 1, 0, 2);
+
+    // apply e3-expansion N-3 times
+    for (int i = 3; i < N; ++i) { expand_three(edge_ab, i, count); }
+}
+
+template <int N>
+int FixedTriangulation<N>::new_twins(int& count) {
+    int edge = count;
+    count += 2;
+    return edge;
+}
+
+template <int N>
+void FixedTriangulation<N>::make_triangle(int edge_a, int edge_b, int edge_c,
+                                          int vertex_a, int vertex_b, int vertex_c) {
+    next_[edge_a] = edge_b;
+    next_[edge_b] = edge_c;
+    next_[edge_c] = edge_a;
+    edge_[vertex_a] = edge_c;
+    edge_[vertex_b] = edge_a;
+    edge_[vertex_c] = edge_b;
+    target_[edge_a] = vertex_c;
+    target_[edge_b] = vertex_a;
+    target_[edge_c] = vertex_b;
+    adjacency_[vertex_a] |= (1u << vertex_b) | (1u << vertex_c);
+    adjacency_[vertex_b] |= (1u << vertex_c) | (1u << vertex_a);
+    adjacency_[vertex_c] |= (1u << vertex_a) | (1u << vertex_b);
+}
+
+template <int N>
+void FixedTriangulation<N>::expand_three(int edge, int vertex, int& count) {
+    int edge_ab = edge;
+    int edge_bc = next(edge);
+    int edge_ca = prev(edge);
+    int vertex_a = target(edge_ca);
+    int vertex_b = target(edge_ab);
+    int vertex_c = target(edge_bc);
+    int edge_bd = new_twins(count);
+    int edge_cd = new_twins(count);
+    int edge_ad = new_twins(count);
+
+    make_triangle(edge_ab, edge_bd, twin(edge_ad), vertex, vertex_a, vertex_b);
+    make_triangle(edge_bc, edge_cd, twin(edge_bd), vertex, vertex_b, vertex_c);
+    make_triangle(edge_ca, edge_ad, twin(edge_cd), vertex, vertex_c, vertex_a);
+}
+
+template <int N>
+bool FixedTriangulation<N>::is_flippable(int edge) const {
+    int vertex_a = target(next(edge));
+    int vertex_b = target(next(twin(edge)));
+    return ((adjacency_[vertex_a] >> vertex_b) & 1u) == 0;
+}
+
+template <int N>
+void FixedTriangulation<N>::flip(int edge) {
+    int twin = this->twin(edge);
+    int vertex_t = target(edge);
+    int vertex_s = target(twin);
+    int edge_ta = next(edge);
+    int edge_as = next(edge_ta);
+    int edge_sb = next(twin);
+    int edge_bt = next(edge_sb);
+    int vertex_a = target(edge_ta);
+    int vertex_b = target(edge_sb);
+
+    next_[edge] = edge_bt;
+    next_[edge_bt] = edge_ta;
+    next_[edge_ta] = edge;
+    next_[twin] = edge_as;
+    next_[edge_as] = edge_sb;
+    next_[edge_sb] = twin;
+    target_[edge] = vertex_b;
+    target_[twin] = vertex_a;
+    if (edge_[vertex_t] == twin) { edge_[vertex_t] = edge_ta; }
+    if (edge_[vertex_s] == edge) { edge_[vertex_s] = edge_sb; }
+
+    adjacency_[vertex_s] &= ~(1u << vertex_t);
+    adjacency_[vertex_t] &= ~(1u << vertex_s);
+    adjacency_[vertex_a] |= 1u << vertex_b;
+    adjacency_[vertex_b] |= 1u << vertex_a;
+}
+
+/* ---------------------------------------------------------------------- *
+ * impementation of the fixed code class
+ * ---------------------------------------------------------------------- */
+
+template <int N>
+FixedCode<N>::FixedCode(const FixedTriangulation<N>& triangulation) {
+    code_.fill(N);
+    for (int i = 0; i < FixedTriangulation<N>::SIZE; ++i) {
+        update(triangulation, i, true);
+        update(triangulation, i, false);
+    }
+}
+
+template <int N>
+void FixedCode<N>::update(const FixedTriangulation<N>& triangulation, int edge, bool clockwise) {
+    std::array<unsigned char, N> labels;
+    std::array<unsigned char, N> queue;
+    labels.fill(0);
+
+    int head = 0;
+    int tail = 0;
+    int index = 1;
+    int label = 1;
+    bool smaller = false;
+
+    // breadth first search
+    labels[triangulation.target(edge)] = label++;
+    queue[tail++] = edge;
+    while (head < tail) {
+        int first = triangulation.twin(queue[head++]);
+        int current = first;
+
+        do {
+            int vertex = triangulation.target(current);
+            if (labels[vertex] == 0) {
+                labels[vertex] = label++;
+                queue[tail++] = current;
+            }
+
+            int symbol = labels[vertex];
+            if (smaller) {
+                code_[index] = symbol;
+            } else if (symbol < code_[index]) {
+                smaller = true;
+                code_[index] = symbol;
+            } else if (symbol > code_[index]) {
+                return;
+            }
+
+            index++;
+            current = clockwise ? triangulation.next(triangulation.twin(current))
+                                : triangulation.twin(triangulation.prev(current));
+        } while (current != first);
+
+        // mark end of current vertex's phase
+        if (code_[index] > 0) { smaller = true; }
+        code_[index++] = 0;
+    }
+}
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
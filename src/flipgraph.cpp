@@ -4,84 +4,406 @@
  * author: jerome dohrau
  * ---------------------------------------------------------------------- */
 
-#ifndef __FG_FLIP_GRAPH__
-#define __FG_FLIP_GRAPH__
-
 #include "flipgraph.hpp"
 #include "triangulation.hpp"
+#include "fixed_triangulation.hpp"
+#include "code_batch.hpp"
 
 #include <vector>
 #include <queue>
+#include <deque>
 #include <map>
+#include <unordered_set>
 #include <utility>
 #include <iostream>
+#include <fstream>
 #include <algorithm>
+#include <cstring>
+#include <cstdint>
 
 /* ---------------------------------------------------------------------- *
  * flip graph
  *
  * possible improvements
- *  - use vector<set<int>> as datastructure for graph
- *  - use indices.find() to check whether triangulation already exists and
- *    reuse pointer to get index if it exists
  *  - only flip edges that are different in the context of isomorphism
  * ---------------------------------------------------------------------- */
  
 void compute_flip_graph(int n, std::vector<std::vector<int> >& graph) {
+    CsrGraph csr_graph;
+    compute_flip_graph(n, csr_graph);
+    csr_graph.to_lists(graph);
+}
+
+void compute_flip_graph(int n, CsrGraph& graph) {
+    std::vector<int> code_order;
+    compute_flip_graph(n, graph, code_order);
+}
+
+void compute_flip_graph(int n, CsrGraph& graph, std::vector<int>& code_order) {
     graph.clear();
+    GraphBuilder builder(graph);
+    compute_flip_graph(n, builder, code_order);
+}
+
+void compute_flip_graph(int n, GraphBuilder& builder, std::vector<int>& code_order) {
+    MemoryBudget budget;
+    compute_flip_graph(n, builder, code_order, budget);
+}
+
+/* ---------------------------------------------------------------------- *
+ * search with a memory budget
+ *
+ * the frontier refers to the entries of the index, from which the
+ * triangulations are rebuilt when they are expanded. rebuilding is cheaper
+ * than copying every discovered triangulation and keeps the frontier small.
+ * the memory of the search is accounted after every expanded triangulation.
+ * ---------------------------------------------------------------------- */
+
+namespace {
+
+typedef std::map<Code, int> IndexMap;
+
+// the entry in the index of a triangulation waiting to be expanded
+typedef IndexMap::const_iterator FrontierEntry;
+
+// the number of expanded triangulations between two progress reports
+const int progress_interval = 1 << 14;
+
+// the magic of a checkpoint
+const char checkpoint_magic[] = "FGC1";
+
+struct Search {
+    // the number of vertices of the triangulations
+    int n;
+
+    // the index of every discovered triangulation
+    IndexMap indices;
+
+    // the triangulations waiting to be expanded in the order of their indices
+    std::deque<FrontierEntry> frontier;
+};
+
+// returns the bytes of an index of the specified number of codes, without
+// the codes. a tree node holds a color and three pointers besides its value
+long long index_memory(long long count) {
+    return count * heap_block(32 + sizeof(IndexMap::value_type));
+}
+
+MemoryUsage memory_usage(const Search& search, const GraphBuilder& builder) {
+    long long count = (long long) search.indices.size();
+    int length = search.n + 6 * search.n - 12 + 1;
+
+    MemoryUsage usage;
+    usage.index = index_memory(count);
+    usage.codes = count * heap_block(length);
+    usage.frontier = (long long) search.frontier.size() * sizeof(FrontierEntry);
+    usage.adjacency = builder.memory();
+    return usage;
+}
+
+void write_uint32(uint32_t value, std::ostream& output_stream) {
+    char bytes[4];
+    for (int i = 0; i < 4; ++i) { bytes[i] = (char) ((value >> (8 * i)) & 0xff); }
+    output_stream.write(bytes, 4);
+}
+
+bool read_uint32(std::istream& input_stream, int& value) {
+    unsigned char bytes[4];
+    if (!input_stream.read((char*) bytes, 4)) { return false; }
+    value = (int) ((uint32_t) bytes[0] | ((uint32_t) bytes[1] << 8) | ((uint32_t) bytes[2] << 16)
+                   | ((uint32_t) bytes[3] << 24));
+    return true;
+}
+
+// writes the magic, n, the next index, the number and the length of the
+// codes as 32-bit little-endian integers followed by the codes
+bool write_checkpoint(const Search& search, int next, const std::string& path) {
+    int count = (int) search.indices.size();
+    std::vector<const Code*> codes(count);
+    IndexMap::const_iterator it;
+    for (it = search.indices.begin(); it != search.indices.end(); ++it) { codes[it->second] = &it->first; }
+
+    std::ofstream output_stream(path.c_str(), std::ios::out | std::ios::binary);
+    int length = codes[0]->length();
+    output_stream.write(checkpoint_magic, 4);
+    write_uint32(search.n, output_stream);
+    write_uint32(next, output_stream);
+    write_uint32(count, output_stream);
+    write_uint32(length, output_stream);
+    for (int i = 0; i < count; ++i) { output_stream.write((const char*) codes[i]->symbols(), length); }
+    output_stream.close();
+    return !output_stream.fail();
+}
+
+// expands the frontier until it is empty or the budget is exceeded
+bool run_search(Search& search, GraphBuilder& builder, std::vector<int>& code_order, MemoryBudget& budget,
+                const Predicate* predicate) {
+    int count = (int) search.indices.size();
+
+    // vertices are dequeued in the order of their indices, hence their
+    // adjacency lists can be appended one by one
+    CodeBatch batch;
+    std::vector<Edge*> edges;
+    std::vector<Code> codes;
+    while (!search.frontier.empty()) {
+        // get current triangulation
+        Triangulation triangulation(search.frontier.front()->first);
+        search.frontier.pop_front();
+
+        // canonicalize all accepted neighboring triangulations at once
+        collect_flips(triangulation, predicate, edges);
+        batch.compute_codes(triangulation, edges, codes);
+
+        // loop through neighboring triangulations
+        int k = (int) edges.size();
+        for (int i = 0; i < k; ++i) {
+            std::pair<IndexMap::iterator, bool> result = search.indices.insert(std::make_pair(codes[i], count));
+            if (result.second) {
+                // add newly discovered triangulation
+                count++;
+                search.frontier.push_back(result.first);
+            }
+
+            // duplicates are removed when the vertex is finished
+            builder.add_neighbor(result.first->second);
+        }
+
+        builder.finish_vertex();
+
+        // account memory
+        MemoryUsage usage = memory_usage(search, builder);
+        if (budget.progress && builder.count() % progress_interval == 0) {
+            *budget.progress << "expanded: " << builder.count() << ", discovered: " << count << ", ";
+            write_memory_usage(usage, *budget.progress);
+        }
+        if (budget.update(usage)) {
+            budget.aborted = true;
+            budget.checkpointed = write_checkpoint(search, builder.count(), budget.checkpoint);
+            code_order.clear();
+            return false;
+        }
+    }
+
+    // the index map is sorted by code
+    code_order.clear();
+    code_order.reserve(count);
+    IndexMap::iterator it;
+    for (it = search.indices.begin(); it != search.indices.end(); ++it) {
+        code_order.push_back(it->second);
+        builder.set_code(it->second, it->first.symbols(), it->first.length());
+    }
+    return true;
+}
+
+}
+
+bool compute_flip_graph(int n, GraphBuilder& builder, std::vector<int>& code_order, MemoryBudget& budget,
+                        const Predicate* predicate) {
+    Search search;
+    search.n = n;
+
+    // add start triangulations
+    std::vector<Code> starts;
+    find_start_codes(n, predicate, starts);
+    for (size_t i = 0; i < starts.size(); ++i) {
+        int count = (int) search.indices.size();
+        search.frontier.push_back(search.indices.insert(std::make_pair(starts[i], count)).first);
+    }
+
+    return run_search(search, builder, code_order, budget, predicate);
+}
+
+long long checkpoint_memory(const Checkpoint& checkpoint) {
+    long long count = (long long) (checkpoint.symbols.size() / checkpoint.length);
+    return index_memory(count) + count * heap_block(checkpoint.length);
+}
+
+bool resume_flip_graph(const Checkpoint& checkpoint, GraphBuilder& builder, std::vector<int>& code_order,
+                       MemoryBudget& budget, const Predicate* predicate) {
+    Search search;
+    search.n = checkpoint.n;
+
+    // the triangulations that were not expanded are rebuilt from their codes
+    int count = (int) (checkpoint.symbols.size() / checkpoint.length);
+    std::vector<IndexMap::const_iterator> entries(count);
+    for (int i = 0; i < count; ++i) {
+        Code code(checkpoint.symbols.data() + (size_t) i * checkpoint.length, checkpoint.length);
+        entries[i] = search.indices.insert(std::make_pair(code, i)).first;
+    }
+    for (int i = checkpoint.next; i < count; ++i) {
+        search.frontier.push_back(entries[i]);
+    }
+
+    return run_search(search, builder, code_order, budget, predicate);
+}
+
+bool read_checkpoint(const std::string& path, Checkpoint& checkpoint) {
+    std::ifstream input_stream(path.c_str(), std::ios::in | std::ios::binary);
+    char magic[4];
+    if (!input_stream.read(magic, 4) || std::memcmp(magic, checkpoint_magic, 4) != 0) { return false; }
+
+    int count;
+    if (!read_uint32(input_stream, checkpoint.n) || !read_uint32(input_stream, checkpoint.next)
+        || !read_uint32(input_stream, count) || !read_uint32(input_stream, checkpoint.length)) {
+        return false;
+    }
+    if (checkpoint.length != 7 * checkpoint.n - 11 || count < 1 || checkpoint.next < 0 || checkpoint.next > count) {
+        return false;
+    }
+
+    checkpoint.symbols.resize((size_t) count * checkpoint.length);
+    return (bool) input_stream.read((char*) checkpoint.symbols.data(), checkpoint.symbols.size());
+}
+
+/* ---------------------------------------------------------------------- *
+ * flip graph statistics
+ *
+ * the search only keeps the index of all visited triangulations and the
+ * current and next layer of the bfs. layers store pointers into the index
+ * and triangulations are rebuilt from their codes when they are expanded.
+ * distinct fingerprints are only counted for small n, see statistics.hpp.
+ * ---------------------------------------------------------------------- */
+
+void compute_flip_graph_statistics(int n, FlipGraphStatistics& statistics, const Predicate* predicate) {
+    typedef std::map<Code, int> IndexMap;
+
+    statistics = FlipGraphStatistics();
+    statistics.n = n;
     int count = 0;
 
-    std::queue<std::pair<Triangulation*, int> > queue;
-    std::map<Code, int> indices;
+    IndexMap indices;
+    std::vector<IndexMap::const_iterator> layer;
+    std::vector<IndexMap::const_iterator> next_layer;
+
+    // add start triangulations
+    std::vector<Code> starts;
+    find_start_codes(n, predicate, starts);
+    for (size_t i = 0; i < starts.size(); ++i) {
+        layer.push_back(indices.insert(std::make_pair(starts[i], count++)).first);
+    }
+
+    // explore flip graph layer by layer
+    CodeBatch batch;
+    std::vector<Edge*> edges;
+    std::vector<Code> codes;
+    std::vector<int> neighbors;
+    std::unordered_set<uint64_t> fingerprints;
+    bool fingerprinted = n <= max_fingerprinted_order;
+    while (!layer.empty()) {
+        statistics.layers.push_back((long long) layer.size());
+
+        int size = (int) layer.size();
+        for (int j = 0; j < size; ++j) {
+            Triangulation triangulation(layer[j]->first);
+            int index = layer[j]->second;
+            if (fingerprinted) { fingerprints.insert(triangulation.fingerprint()); }
+
+            collect_flips(triangulation, predicate, edges);
+            batch.compute_codes(triangulation, edges, codes);
+
+            neighbors.clear();
+            int k = (int) edges.size();
+            for (int i = 0; i < k; ++i) {
+                std::pair<IndexMap::iterator, bool> result =
+                    indices.insert(std::make_pair(codes[i], count));
+                if (result.second) {
+                    count++;
+                    next_layer.push_back(result.first);
+                }
+                neighbors.push_back(result.first->second);
+            }
+
+            // count distinct neighbors
+            std::sort(neighbors.begin(), neighbors.end());
+            int degree = (int) (std::unique(neighbors.begin(), neighbors.end()) - neighbors.begin());
+            int loops = std::binary_search(neighbors.begin(), neighbors.begin() + degree, index) ? 1 : 0;
+            statistics.add_vertex(degree, loops);
+        }
+
+        layer.swap(next_layer);
+        next_layer.clear();
+    }
+
+    if (fingerprinted) { statistics.fingerprints = (long long) fingerprints.size(); }
+}
+
+/* ---------------------------------------------------------------------- *
+ * flip graph on fixed size triangulations
+ *
+ * same search as above, but triangulations and codes live in arrays of
+ * compile-time size. flipping and canonicalizing a neighbor does not
+ * allocate any memory.
+ * ---------------------------------------------------------------------- */
 
-    // build canonical triangulation on n vertices
-    Triangulation* triangulation = new Triangulation(n);
+template <int N>
+void compute_fixed_flip_graph(GraphBuilder& builder, std::vector<int>& code_order) {
+    typedef std::map<FixedCode<N>, int> IndexMap;
+    int count = 0;
+
+    std::queue<FixedTriangulation<N> > queue;
+    IndexMap indices;
 
     // add canonical triangulation
-    int index = count++;
-    indices[Code(*triangulation)] = 0;
-    graph.push_back(std::vector<int>());
-    queue.push(std::make_pair(triangulation, index));
+    FixedTriangulation<N> triangulation;
+    indices.insert(std::make_pair(FixedCode<N>(triangulation), count++));
+    queue.push(triangulation);
 
     // explore flip graph using a bfs
     while (!queue.empty()) {
-        // get current triangulation
-        triangulation = queue.front().first;
-        index = queue.front().second;
+        triangulation = queue.front();
         queue.pop();
 
         // loop through neighboring triangulations
-        int m = triangulation->size();
-        for (int i = 0; i < m; ++i) {
-            Edge* edge = triangulation->edge(i);
-            if (triangulation->is_representative(edge) && triangulation->is_flippable(edge)) {
-                triangulation->flip(edge);
-
-                Code code(*triangulation);
-                int other_index = 0;
-                // todo: faster if using indices.find() and reuse pointer to position
-                if (indices.count(code) == 0) {
-                    // add newly discovered triangulation
-                    other_index = count++;
-                    indices[code] = other_index;
-                    graph.push_back(std::vector<int>());
-                    queue.push(std::make_pair(new Triangulation(*triangulation), other_index));
-                } else {
-                    // get index of triangulation
-                    other_index = indices[code];
-                }
+        for (int edge = 0; edge < FixedTriangulation<N>::SIZE; ++edge) {
+            if (triangulation.is_representative(edge) && triangulation.is_flippable(edge)) {
+                triangulation.flip(edge);
 
-                // add edge if not already present
-                if (std::count(graph[index].begin(), graph[index].end(), other_index) == 0) {
-                    graph[index].push_back(other_index);
+                std::pair<typename IndexMap::iterator, bool> result =
+                    indices.insert(std::make_pair(FixedCode<N>(triangulation), count));
+                if (result.second) {
+                    // add newly discovered triangulation
+                    count++;
+                    queue.push(triangulation);
                 }
+                builder.add_neighbor(result.first->second);
 
                 // note: after two flips the edge and its twin are swapped
-                triangulation->flip(edge);
+                triangulation.flip(edge);
             }
         }
 
-        delete triangulation;
+        builder.finish_vertex();
+    }
+
+    // the index map is sorted by code
+    code_order.clear();
+    code_order.reserve(count);
+    typename IndexMap::iterator it;
+    for (it = indices.begin(); it != indices.end(); ++it) {
+        code_order.push_back(it->second);
+        builder.set_code(it->second, it->first.symbols(), it->first.length());
+    }
+}
+
+bool compute_fixed_flip_graph(int n, CsrGraph& graph, std::vector<int>& code_order) {
+    if (n < 4 || n > max_fixed_order) { return false; }
+    graph.clear();
+    GraphBuilder builder(graph);
+    return compute_fixed_flip_graph(n, builder, code_order);
+}
+
+bool compute_fixed_flip_graph(int n, GraphBuilder& builder, std::vector<int>& code_order) {
+    switch (n) {
+        case 4: compute_fixed_flip_graph<4>(builder, code_order); return true;
+        case 5: compute_fixed_flip_graph<5>(builder, code_order); return true;
+        case 6: compute_fixed_flip_graph<6>(builder, code_order); return true;
+        case 7: compute_fixed_flip_graph<7>(builder, code_order); return true;
+        case 8: compute_fixed_flip_graph<8>(builder, code_order); return true;
+        case 9: compute_fixed_flip_graph<9>(builder, code_order); return true;
+        case 10: compute_fixed_flip_graph<10>(builder, code_order); return true;
+        case 11: compute_fixed_flip_graph<11>(builder, code_order); return true;
+        case 12: compute_fixed_flip_graph<12>(builder, code_order); return true;
+        default: return false;
     }
 }
 
@@ -95,11 +417,20 @@ void write_flip_graph(std::vector<std::vector<int> >& graph, std::ostream& outpu
         int degree = (int) graph[i].size();
         output_stream << i << ":";
         for (int j = 0; j < degree; ++j) { output_stream << " " << graph[i][j]; }
-        output_stream << std::endl;
+        output_stream << "\n";
     }
 }
 
-#endif
+void write_flip_graph(const CsrGraph& graph, std::ostream& output_stream) {
+    int size = graph.order();
+    for (int i = 0; i < size; ++i) {
+        int degree = graph.degree(i);
+        const int* neighbors = graph.neighbors(i);
+        output_stream << i << ":";
+        for (int j = 0; j < degree; ++j) { output_stream << " " << neighbors[j]; }
+        output_stream << "\n";
+    }
+}
 
 /* ---------------------------------------------------------------------- *
  * end of file
@@ -7,17 +7,94 @@
 #ifndef __FG_FLIP_GRAPH__
 #define __FG_FLIP_GRAPH__
 
+#include "graph.hpp"
+#include "statistics.hpp"
+#include "memory.hpp"
+#include "predicate.hpp"
+
 #include <vector>
 #include <queue>
 #include <map>
+#include <string>
 #include <utility>
+#include <iostream>
+
+// the state of a search that was stopped. the codes of all discovered
+// triangulations are stored in the order of their indices. the
+// triangulations before the next index were already expanded
+struct Checkpoint {
+    // the number of vertices of the triangulations
+    int n;
+
+    // the index of the next triangulation to expand
+    int next;
+
+    // the length of every code
+    int length;
+
+    // the symbols of all codes
+    std::vector<unsigned char> symbols;
+};
+
+// reads the checkpoint from the specified file. returns false if the file
+// cannot be read or is malformed
+bool read_checkpoint(const std::string& path, Checkpoint& checkpoint);
 
 // computes the flip graph on all triangulations with n vertices
 void compute_flip_graph(int n, std::vector<std::vector<int> >& graph);
 
+// computes the flip graph on all triangulations with n vertices
+void compute_flip_graph(int n, CsrGraph& graph);
+
+// computes the flip graph on all triangulations with n vertices and the
+// indices of its vertices ordered by the canonical codes of the triangulations
+void compute_flip_graph(int n, CsrGraph& graph, std::vector<int>& code_order);
+
+// computes the flip graph on all triangulations with n vertices and the
+// indices of its vertices ordered by code. the vertices are passed to the
+// specified builder in the order of their indices
+void compute_flip_graph(int n, GraphBuilder& builder, std::vector<int>& code_order);
+
+// computes the flip graph on all triangulations with n vertices within the
+// specified memory budget. the vertices are passed to the specified builder
+// in the order of their indices. returns false if the budget was exceeded,
+// in which case a checkpoint is written, the budget records whether that
+// succeeded and code_order is empty. if a
+// predicate is specified, the search only explores the accepted
+// triangulations reachable from the start triangulations by accepted flips
+bool compute_flip_graph(int n, GraphBuilder& builder, std::vector<int>& code_order, MemoryBudget& budget,
+                        const Predicate* predicate = 0);
+
+// returns the bytes of the index and the codes a search resumed at the
+// specified checkpoint starts with
+long long checkpoint_memory(const Checkpoint& checkpoint);
+
+// continues the search stopped at the specified checkpoint. the builder has
+// to start at the next index of the checkpoint and the predicate has to be
+// the one of the stopped search
+bool resume_flip_graph(const Checkpoint& checkpoint, GraphBuilder& builder, std::vector<int>& code_order,
+                       MemoryBudget& budget, const Predicate* predicate = 0);
+
+// computes the flip graph on all triangulations with n vertices using the
+// fixed size triangulations. returns false if n is not supported
+bool compute_fixed_flip_graph(int n, CsrGraph& graph, std::vector<int>& code_order);
+
+// computes the flip graph on all triangulations with n vertices using the
+// fixed size triangulations and passes its vertices to the specified
+// builder. returns false if n is not supported
+bool compute_fixed_flip_graph(int n, GraphBuilder& builder, std::vector<int>& code_order);
+
+// computes the statistics of the flip graph on all triangulations with n
+// vertices without storing its edges. a predicate restricts the search like
+// it does for compute_flip_graph
+void compute_flip_graph_statistics(int n, FlipGraphStatistics& statistics, const Predicate* predicate = 0);
+
 // writes the specified flip graph to the specified stream
 void write_flip_graph(std::vector<std::vector<int> >& graph, std::ostream& output_stream);
 
+// writes the specified flip graph to the specified stream
+void write_flip_graph(const CsrGraph& graph, std::ostream& output_stream);
+
 #endif
 
 /* ---------------------------------------------------------------------- *
@@ -7,6 +7,7 @@
  #include "functions.hpp"
 
  #include <queue>
+ #include <algorithm>
 
  int vertex_eccentricity(Graph& graph, int vertex) {
     int n = (int) graph.size();
@@ -50,6 +51,109 @@ int graph_diameter(Graph& graph) {
     return result;
 }
 
+int vertex_eccentricity(const CsrGraph& graph, int vertex) {
+    int n = graph.order();
+    int result = 0;
+
+    // the queue is a flat array since every vertex is enqueued at most once
+    std::vector<int> distances(n, -1);
+    std::vector<int> queue(n);
+    int head = 0;
+    int tail = 0;
+
+    distances[vertex] = 0;
+    queue[tail++] = vertex;
+
+    while (head < tail) {
+        int index = queue[head++];
+        int distance = distances[index];
+
+        result = std::max(result, distance);
+
+        int degree = graph.degree(index);
+        const int* neighbors = graph.neighbors(index);
+        for (int i = 0; i < degree; ++i) {
+            int neighbor = neighbors[i];
+            if (distances[neighbor] < 0) {
+                distances[neighbor] = distance + 1;
+                queue[tail++] = neighbor;
+            }
+        }
+    }
+
+    return result;
+}
+
+int graph_diameter(const CsrGraph& graph) {
+    int n = graph.order();
+    int result = 0;
+
+    for (int i = 0; i < n; ++i) {
+        int eccentricity = vertex_eccentricity(graph, i);
+        result = std::max(result, eccentricity);
+    }
+
+    return result;
+}
+
+int graph_diameter(const CsrGraph& graph, Scheduler& scheduler) {
+    std::vector<int> eccentricities;
+    vertex_eccentricities(graph, eccentricities, scheduler);
+    return eccentricities.empty() ? 0 : *std::max_element(eccentricities.begin(), eccentricities.end());
+}
+
+void vertex_eccentricities(const CsrGraph& graph, std::vector<int>& eccentricities) {
+    int n = graph.order();
+    eccentricities.resize(n);
+    for (int i = 0; i < n; ++i) { eccentricities[i] = vertex_eccentricity(graph, i); }
+}
+
+void vertex_eccentricities(const CsrGraph& graph, std::vector<int>& eccentricities, Scheduler& scheduler) {
+    // every task computes the eccentricities of a chunk of vertices
+    const int chunk_size = 16;
+    int n = graph.order();
+    int chunks = (n + chunk_size - 1) / chunk_size;
+    eccentricities.resize(n);
+    scheduler.run(chunks, [&](int, int chunk) {
+        int last = std::min(n, (chunk + 1) * chunk_size);
+        for (int i = chunk * chunk_size; i < last; ++i) { eccentricities[i] = vertex_eccentricity(graph, i); }
+    });
+}
+
+void write_graph_analysis(const CsrGraph& graph, std::ostream& output_stream, Scheduler& scheduler) {
+    int n = graph.order();
+    int loops = 0;
+    int min_degree = n > 0 ? graph.degree(0) : 0;
+    int max_degree = 0;
+
+    for (int i = 0; i < n; ++i) {
+        min_degree = std::min(min_degree, graph.degree(i));
+        max_degree = std::max(max_degree, graph.degree(i));
+        const int* neighbors = graph.neighbors(i);
+        for (int j = 0; j < graph.degree(i); ++j) {
+            if (neighbors[j] == i) { loops++; }
+        }
+    }
+
+    std::vector<int> eccentricities;
+    vertex_eccentricities(graph, eccentricities, scheduler);
+    int radius = n > 0 ? eccentricities[0] : 0;
+    int diameter = 0;
+    for (int i = 0; i < n; ++i) {
+        radius = std::min(radius, eccentricities[i]);
+        diameter = std::max(diameter, eccentricities[i]);
+    }
+
+    output_stream << "vertices: " << n << "\n";
+    output_stream << "edges: " << (graph.size() + loops) / 2 << "\n";
+    output_stream << "loops: " << loops << "\n";
+    output_stream << "min degree: " << min_degree << "\n";
+    output_stream << "max degree: " << max_degree << "\n";
+    output_stream << "radius: " << radius << "\n";
+    output_stream << "diameter: " << diameter << "\n";
+    if (scheduler.threads() > 1) { write_scheduler_statistics(scheduler.statistics(), output_stream); }
+}
+
 /* ---------------------------------------------------------------------- *
  * end of file
  * ---------------------------------------------------------------------- */
\ No newline at end of file
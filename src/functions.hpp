@@ -5,7 +5,11 @@
  #ifndef __FG_FUNCTIONS__
  #define __FG_FUNCTIONS__
 
+ #include "graph.hpp"
+ #include "scheduler.hpp"
+
  #include <vector>
+ #include <iostream>
 
  typedef std::vector<std::vector<int> > Graph;
 
@@ -15,6 +19,25 @@
 // computes the diameter of the specified graph
  int graph_diameter(Graph& graph);
 
+// computes the eccentricity of the vertex with the specified index in the given graph
+ int vertex_eccentricity(const CsrGraph& graph, int index);
+
+// computes the diameter of the specified graph
+ int graph_diameter(const CsrGraph& graph);
+
+// computes the diameter of the specified graph using the specified scheduler
+ int graph_diameter(const CsrGraph& graph, Scheduler& scheduler);
+
+// computes the eccentricities of all vertices of the specified graph
+ void vertex_eccentricities(const CsrGraph& graph, std::vector<int>& eccentricities);
+
+// computes the eccentricities of all vertices of the specified graph using the specified scheduler
+ void vertex_eccentricities(const CsrGraph& graph, std::vector<int>& eccentricities, Scheduler& scheduler);
+
+// writes the order, size, degrees, radius and diameter of the specified graph to the specified stream,
+// followed by the statistics of the scheduler if it has more than one thread
+ void write_graph_analysis(const CsrGraph& graph, std::ostream& output_stream, Scheduler& scheduler);
+
  #endif
 
 /* ---------------------------------------------------------------------- *
@@ -0,0 +1,130 @@
+/* ---------------------------------------------------------------------- *
+ * graph.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "graph.hpp"
+#include "writer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the csr graph class
+ * ---------------------------------------------------------------------- */
+
+CsrGraph::CsrGraph() {
+    offsets_.push_back(0);
+}
+
+long long CsrGraph::memory() const {
+    return (long long) (offsets_.capacity() + neighbors_.capacity()) * sizeof(int);
+}
+
+CsrGraph::CsrGraph(const std::vector<std::vector<int> >& graph) {
+    offsets_.push_back(0);
+    GraphBuilder builder(*this);
+    int n = (int) graph.size();
+    for (int i = 0; i < n; ++i) {
+        int degree = (int) graph[i].size();
+        for (int j = 0; j < degree; ++j) { builder.add_neighbor(graph[i][j]); }
+        builder.finish_vertex();
+    }
+}
+
+int CsrGraph::order() const {
+    return (int) offsets_.size() - 1;
+}
+
+int CsrGraph::size() const {
+    return (int) neighbors_.size();
+}
+
+int CsrGraph::degree(int i) const {
+    return offsets_[i + 1] - offsets_[i];
+}
+
+int CsrGraph::neighbor(int i, int j) const {
+    return neighbors_[offsets_[i] + j];
+}
+
+const int* CsrGraph::neighbors(int i) const {
+    return neighbors_.data() + offsets_[i];
+}
+
+void CsrGraph::assign(std::vector<int>& offsets, std::vector<int>& neighbors) {
+    offsets_.swap(offsets);
+    neighbors_.swap(neighbors);
+    offsets.clear();
+    neighbors.clear();
+}
+
+void CsrGraph::append(const CsrGraph& graph) {
+    int offset = (int) neighbors_.size();
+    int n = graph.order();
+    neighbors_.insert(neighbors_.end(), graph.neighbors_.begin(), graph.neighbors_.end());
+    for (int i = 1; i <= n; ++i) { offsets_.push_back(offset + graph.offsets_[i]); }
+}
+
+void CsrGraph::to_lists(std::vector<std::vector<int> >& graph) const {
+    int n = order();
+    graph.clear();
+    graph.resize(n);
+    for (int i = 0; i < n; ++i) {
+        graph[i].assign(neighbors(i), neighbors(i) + degree(i));
+    }
+}
+
+void CsrGraph::clear() {
+    offsets_.clear();
+    neighbors_.clear();
+    offsets_.push_back(0);
+}
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the graph builder class
+ * ---------------------------------------------------------------------- */
+
+GraphBuilder::GraphBuilder(CsrGraph& graph) : graph_(&graph), writer_(0), count_(0), codes_(0) {}
+
+GraphBuilder::GraphBuilder(GraphWriter& writer, int first) : graph_(0), writer_(&writer), count_(first), codes_(0) {}
+
+void GraphBuilder::add_neighbor(int index) {
+    scratch_.push_back(index);
+}
+
+void GraphBuilder::finish_vertex() {
+    std::sort(scratch_.begin(), scratch_.end());
+    std::vector<int>::iterator end = std::unique(scratch_.begin(), scratch_.end());
+    if (graph_) {
+        graph_->neighbors_.insert(graph_->neighbors_.end(), scratch_.begin(), end);
+        graph_->offsets_.push_back((int) graph_->neighbors_.size());
+    } else {
+        writer_->write_vertex(count_, scratch_.data(), (int) (end - scratch_.begin()));
+    }
+    scratch_.clear();
+    count_++;
+}
+
+int GraphBuilder::count() const {
+    return count_;
+}
+
+long long GraphBuilder::memory() const {
+    long long scratch = (long long) scratch_.capacity() * sizeof(int);
+    return scratch + (graph_ ? graph_->memory() : writer_->memory());
+}
+
+void GraphBuilder::record_codes(std::vector<unsigned char>& codes) {
+    codes_ = &codes;
+}
+
+void GraphBuilder::set_code(int index, const unsigned char* symbols, int length) {
+    if (!codes_) { return; }
+    size_t offset = (size_t) index * length;
+    if (codes_->size() < offset + length) { codes_->resize(offset + length); }
+    std::memcpy(codes_->data() + offset, symbols, length);
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
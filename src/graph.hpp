@@ -0,0 +1,137 @@
+/* ---------------------------------------------------------------------- *
+ * graph.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_GRAPH__
+#define __FG_GRAPH__
+
+#include <vector>
+
+/* ---------------------------------------------------------------------- *
+ * forward declarations
+ * ---------------------------------------------------------------------- */
+
+class CsrGraph;
+class GraphBuilder;
+class GraphWriter;
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the csr graph class
+ *
+ * the adjacency lists of all vertices are stored back to back in a single
+ * array. the neighbors of the i-th vertex are found at the positions
+ * offsets_[i] to offsets_[i + 1] - 1 of that array.
+ * ---------------------------------------------------------------------- */
+
+class CsrGraph {
+    friend class GraphBuilder;
+
+public:
+    // constructor that builds an empty graph
+    CsrGraph();
+
+    // constructor that builds a graph from the specified adjacency lists
+    CsrGraph(const std::vector<std::vector<int> >& graph);
+
+private:
+    // the offsets of the adjacency lists
+    std::vector<int> offsets_;
+
+    // the concatenated adjacency lists
+    std::vector<int> neighbors_;
+
+public:
+    // returns the number of vertices
+    int order() const;
+
+    // returns the total length of all adjacency lists
+    int size() const;
+
+    // returns the degree of the i-th vertex
+    int degree(int i) const;
+
+    // returns the j-th neighbor of the i-th vertex
+    int neighbor(int i, int j) const;
+
+    // returns a pointer to the adjacency list of the i-th vertex
+    const int* neighbors(int i) const;
+
+    // replaces the contents of this graph by the specified offsets and
+    // adjacency lists. the specified vectors are left empty
+    void assign(std::vector<int>& offsets, std::vector<int>& neighbors);
+
+    // appends the vertices of the specified graph to this graph
+    void append(const CsrGraph& graph);
+
+    // converts this graph into adjacency lists
+    void to_lists(std::vector<std::vector<int> >& graph) const;
+
+    // removes all vertices from the graph
+    void clear();
+
+    // returns the number of bytes allocated by the graph
+    long long memory() const;
+};
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the graph builder class
+ *
+ * the builder appends one vertex at a time to a csr graph or passes it on
+ * to a graph writer. neighbors are collected in a scratch buffer that is
+ * sorted and deduplicated before it is appended, hence each thread should
+ * use a builder of its own.
+ * ---------------------------------------------------------------------- */
+
+class GraphBuilder {
+public:
+    // constructor that appends to the specified graph
+    GraphBuilder(CsrGraph& graph);
+
+    // constructor that writes to the specified writer. the vertices are
+    // numbered starting at the specified index
+    GraphBuilder(GraphWriter& writer, int first = 0);
+
+private:
+    // the graph being built or null
+    CsrGraph* graph_;
+
+    // the writer being written to or null
+    GraphWriter* writer_;
+
+    // the number of finished vertices
+    int count_;
+
+    // the neighbors of the current vertex
+    std::vector<int> scratch_;
+
+    // the recorded codes of the vertices or null
+    std::vector<unsigned char>* codes_;
+
+public:
+    // adds the specified neighbor to the current vertex
+    void add_neighbor(int index);
+
+    // appends the current vertex to the graph and starts the next one
+    void finish_vertex();
+
+    // returns the number of finished vertices, including the vertices
+    // skipped by the first index
+    int count() const;
+
+    // returns the number of bytes allocated by the graph or the writer
+    long long memory() const;
+
+    // records the codes of the vertices in the specified vector. the code of
+    // the vertex with index i starts at i times the length of the codes
+    void record_codes(std::vector<unsigned char>& codes);
+
+    // stores the specified code of the vertex with the specified index if
+    // codes are recorded. engines set the codes of all vertices at the end
+    void set_code(int index, const unsigned char* symbols, int length);
+};
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
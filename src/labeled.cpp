@@ -0,0 +1,212 @@
+/* ---------------------------------------------------------------------- *
+ * labeled.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "labeled.hpp"
+
+#include <vector>
+#include <unordered_set>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+/* ---------------------------------------------------------------------- *
+ * helper functions
+ * ---------------------------------------------------------------------- */
+
+namespace {
+
+// returns the edge from the specified vertex to its smallest neighbor
+Edge* smallest_edge(Vertex* vertex) {
+    Edge* first = vertex->edge();
+    Edge* smallest = first;
+    Edge* current = first->twin()->next();
+    while (current != first) {
+        if (current->target()->index() < smallest->target()->index()) { smallest = current; }
+        current = current->twin()->next();
+    }
+    return smallest;
+}
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the labeled index
+ *
+ * a hash set of the indices of the labeled codes, which are stored back to
+ * back in an arena. a code is appended to the arena before it is looked up
+ * and removed again if it is already present.
+ * ---------------------------------------------------------------------- */
+
+class LabeledIndex {
+public:
+    // constructor that builds an index for codes of the specified length
+    LabeledIndex(int length);
+
+private:
+    // hashes the code with the specified index
+    struct Hash {
+        const LabeledIndex* index;
+        size_t operator ()(int i) const;
+    };
+
+    // compares the codes with the specified indices
+    struct Equal {
+        const LabeledIndex* index;
+        bool operator ()(int i, int j) const;
+    };
+
+    // the length of every code
+    int length_;
+
+    // the symbols of all codes
+    std::vector<unsigned char> arena_;
+
+    // the indices of all codes
+    std::unordered_set<int, Hash, Equal> indices_;
+
+public:
+    // inserts the specified code unless it is already present. returns the
+    // index of the code and sets inserted to whether it was added
+    int insert(const unsigned char* symbols, bool& inserted);
+
+    // returns the code with the specified index
+    Code code(int index) const;
+
+    // returns the symbols of the code with the specified index
+    const unsigned char* symbols(int index) const;
+
+    // returns the number of codes
+    int size() const;
+};
+
+LabeledIndex::LabeledIndex(int length) :
+    length_(length), indices_(16, Hash{this}, Equal{this}) {}
+
+size_t LabeledIndex::Hash::operator ()(int i) const {
+    // fnv-1a followed by the finalizer of splitmix64
+    const unsigned char* symbols = index->symbols(i);
+    uint64_t h = 14695981039346656037ull;
+    for (int j = 0; j < index->length_; ++j) {
+        h ^= symbols[j];
+        h *= 1099511628211ull;
+    }
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return (size_t) h;
+}
+
+bool LabeledIndex::Equal::operator ()(int i, int j) const {
+    return std::memcmp(index->symbols(i), index->symbols(j), index->length_) == 0;
+}
+
+int LabeledIndex::insert(const unsigned char* symbols, bool& inserted) {
+    int index = size();
+    arena_.insert(arena_.end(), symbols, symbols + length_);
+    std::pair<std::unordered_set<int, Hash, Equal>::iterator, bool> result = indices_.insert(index);
+    inserted = result.second;
+    if (!inserted) { arena_.resize(arena_.size() - length_); }
+    return *result.first;
+}
+
+Code LabeledIndex::code(int index) const {
+    return Code(symbols(index), length_);
+}
+
+const unsigned char* LabeledIndex::symbols(int index) const {
+    return arena_.data() + (size_t) index * length_;
+}
+
+int LabeledIndex::size() const {
+    return (int) (arena_.size() / length_);
+}
+
+}
+
+/* ---------------------------------------------------------------------- *
+ * labeled codes
+ * ---------------------------------------------------------------------- */
+
+void compute_labeled_code(const Triangulation& triangulation, unsigned char* symbols) {
+    int n = triangulation.order();
+    int index = 0;
+    symbols[index++] = (unsigned char) n;
+
+    // the orientation in which the smallest neighbor of the first vertex is
+    // followed by the smaller neighbor
+    Edge* edge = smallest_edge(triangulation.vertex(0));
+    bool clockwise = edge->twin()->next()->target()->index() < edge->prev()->twin()->target()->index();
+
+    for (int i = 0; i < n; ++i) {
+        Edge* first = smallest_edge(triangulation.vertex(i));
+        Edge* current = first;
+        do {
+            symbols[index++] = (unsigned char) (current->target()->index() + 1);
+            current = clockwise ? current->twin()->next() : current->prev()->twin();
+        } while (current != first);
+        symbols[index++] = 0;
+    }
+}
+
+bool is_labeled_flippable(Triangulation& triangulation, Edge* edge, bool fixed_outer) {
+    if (fixed_outer && edge->target()->index() < 3 && edge->twin()->target()->index() < 3) { return false; }
+    return triangulation.is_flippable(edge);
+}
+
+/* ---------------------------------------------------------------------- *
+ * labeled flip graph
+ * ---------------------------------------------------------------------- */
+
+void compute_labeled_flip_graph(int n, bool fixed_outer, CsrGraph& graph, std::vector<int>& code_order) {
+    graph.clear();
+    GraphBuilder builder(graph);
+    compute_labeled_flip_graph(n, fixed_outer, builder, code_order);
+}
+
+void compute_labeled_flip_graph(int n, bool fixed_outer, GraphBuilder& builder, std::vector<int>& code_order) {
+    // the vertices 0, 1, 2 of the canonical triangulation form a face
+    int length = 7 * n - 11;
+    std::vector<unsigned char> symbols(length);
+    Triangulation first(n);
+    compute_labeled_code(first, symbols.data());
+    LabeledIndex index(length);
+    bool inserted;
+    index.insert(symbols.data(), inserted);
+
+    // vertices are expanded in the order of their indices, hence the index
+    // doubles as the frontier
+    for (int current = 0; current < index.size(); ++current) {
+        Triangulation triangulation(index.code(current));
+
+        // flipped edges lead to different labeled triangulations, hence the
+        // labeled flip graph has neither loops nor multiple edges
+        int m = triangulation.size();
+        for (int i = 0; i < m; ++i) {
+            Edge* edge = triangulation.edge(i);
+            if (!triangulation.is_representative(edge)) { continue; }
+            if (!is_labeled_flippable(triangulation, edge, fixed_outer)) { continue; }
+
+            triangulation.flip(edge);
+            compute_labeled_code(triangulation, symbols.data());
+            builder.add_neighbor(index.insert(symbols.data(), inserted));
+            triangulation.flip(edge);
+        }
+        builder.finish_vertex();
+    }
+
+    // record the labeled codes and sort the indices by them
+    int count = index.size();
+    code_order.resize(count);
+    for (int i = 0; i < count; ++i) {
+        code_order[i] = i;
+        builder.set_code(i, index.symbols(i), length);
+    }
+    std::sort(code_order.begin(), code_order.end(), [&](int a, int b) {
+        return std::memcmp(index.symbols(a), index.symbols(b), length) < 0;
+    });
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
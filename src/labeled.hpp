@@ -0,0 +1,54 @@
+/* ---------------------------------------------------------------------- *
+ * labeled.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_LABELED__
+#define __FG_LABELED__
+
+#include "triangulation.hpp"
+#include "graph.hpp"
+
+#include <vector>
+
+/* ---------------------------------------------------------------------- *
+ * labeled flip graph
+ *
+ * the vertices of the labeled flip graph are the triangulations whose
+ * vertices are labeled 0 to n - 1, isomorphic triangulations with different
+ * labels are different vertices. a triangulation is identified by its
+ * labeled code, which has the format of a canonical code but uses the
+ * indices of the vertices as labels. every rotation starts at the smallest
+ * neighbor and all rotations follow the orientation in which the smallest
+ * neighbor of the first vertex is followed by the smaller neighbor. since
+ * the embedding of a triangulation is unique up to reflection, the labeled
+ * code only depends on the labeled adjacency structure and is computed in
+ * o(m) without any search.
+ * ---------------------------------------------------------------------- */
+
+// writes the n + m + 1 symbols of the labeled code of the specified
+// triangulation, using the indices of its vertices as labels
+void compute_labeled_code(const Triangulation& triangulation, unsigned char* symbols);
+
+// returns whether the specified edge may be flipped, which is not the case
+// for the edges of the outer triangle 0, 1, 2 if it is fixed
+bool is_labeled_flippable(Triangulation& triangulation, Edge* edge, bool fixed_outer);
+
+/* ---------------------------------------------------------------------- *
+ * function declarations
+ * ---------------------------------------------------------------------- */
+
+// computes the labeled flip graph on all triangulations with n vertices
+// and the indices of its vertices ordered by labeled code. if the outer
+// triangle is fixed, only the triangulations in which 0, 1, 2 is a face are
+// explored and the edges of that face are never flipped
+void compute_labeled_flip_graph(int n, bool fixed_outer, CsrGraph& graph, std::vector<int>& code_order);
+
+// computes the labeled flip graph like the function above and passes its
+// vertices to the specified builder in the order of their indices
+void compute_labeled_flip_graph(int n, bool fixed_outer, GraphBuilder& builder, std::vector<int>& code_order);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
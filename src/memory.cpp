@@ -0,0 +1,58 @@
+/* ---------------------------------------------------------------------- *
+ * memory.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "memory.hpp"
+
+#include <cstdlib>
+#include <algorithm>
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the memory usage
+ * ---------------------------------------------------------------------- */
+
+MemoryUsage::MemoryUsage() : index(0), codes(0), frontier(0), adjacency(0) {}
+
+long long MemoryUsage::total() const {
+    return index + codes + frontier + adjacency;
+}
+
+void write_memory_usage(const MemoryUsage& usage, std::ostream& output_stream) {
+    const double mb = 1024.0 * 1024.0;
+    output_stream << "memory: index " << usage.index / mb << " MB, codes " << usage.codes / mb
+                  << " MB, frontier " << usage.frontier / mb << " MB, adjacency "
+                  << usage.adjacency / mb << " MB, total " << usage.total() / mb << " MB\n";
+}
+
+long long heap_block(long long size) {
+    return std::max(32LL, (size + 8 + 15) / 16 * 16);
+}
+
+bool parse_memory_size(const std::string& text, long long& bytes) {
+    char* end;
+    double value = std::strtod(text.c_str(), &end);
+    if (end == text.c_str() || value <= 0) { return false; }
+
+    std::string suffix(end);
+    if (suffix == "") { bytes = (long long) value; return true; }
+    if (suffix == "k" || suffix == "K") { bytes = (long long) (value * 1024); return true; }
+    if (suffix == "m" || suffix == "M") { bytes = (long long) (value * 1024 * 1024); return true; }
+    if (suffix == "g" || suffix == "G") { bytes = (long long) (value * 1024 * 1024 * 1024); return true; }
+    return false;
+}
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the memory budget
+ * ---------------------------------------------------------------------- */
+
+MemoryBudget::MemoryBudget()
+    : limit(0), checkpoint("flipgraph.checkpoint"), progress(0), aborted(false), checkpointed(false) {}
+
+bool MemoryBudget::update(const MemoryUsage& usage) {
+    if (usage.total() > peak.total()) { peak = usage; }
+    return limit > 0 && usage.total() > limit;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
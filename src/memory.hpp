@@ -0,0 +1,89 @@
+/* ---------------------------------------------------------------------- *
+ * memory.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_MEMORY__
+#define __FG_MEMORY__
+
+#include <string>
+#include <iostream>
+
+/* ---------------------------------------------------------------------- *
+ * memory accounting
+ *
+ * the memory of a search is estimated from the number of elements of its
+ * structures. heap blocks are assumed to carry eight bytes of bookkeeping
+ * and to be rounded up to multiples of sixteen bytes, which is what glibc
+ * does. the estimates do not include memory that was freed but not yet
+ * returned to the system.
+ * ---------------------------------------------------------------------- */
+
+struct MemoryUsage {
+    // the bytes of the index from codes to indices, without the codes
+    long long index;
+
+    // the bytes of the codes
+    long long codes;
+
+    // the bytes of the triangulations waiting to be expanded
+    long long frontier;
+
+    // the bytes of the adjacency lists
+    long long adjacency;
+
+    // constructor that builds an empty usage
+    MemoryUsage();
+
+    // returns the sum of all structures
+    long long total() const;
+};
+
+// writes the specified memory usage on a single line to the specified stream
+void write_memory_usage(const MemoryUsage& usage, std::ostream& output_stream);
+
+// returns the number of bytes allocated for a heap block of the specified size
+long long heap_block(long long size);
+
+// parses a number of bytes with an optional suffix k, m or g. returns false
+// if the specified text is not a size
+bool parse_memory_size(const std::string& text, long long& bytes);
+
+/* ---------------------------------------------------------------------- *
+ * memory budget
+ *
+ * the frontier of a search only refers to the codes in the index and
+ * triangulations are rebuilt when they are expanded. if the budget is
+ * exceeded, the search writes a checkpoint and stops.
+ * ---------------------------------------------------------------------- */
+
+struct MemoryBudget {
+    // the budget in bytes or 0 if there is none
+    long long limit;
+
+    // the path the checkpoint is written to
+    std::string checkpoint;
+
+    // the stream progress is written to or 0
+    std::ostream* progress;
+
+    // the peak usage of the search
+    MemoryUsage peak;
+
+    // whether the search was stopped
+    bool aborted;
+
+    // whether the checkpoint of the stopped search was written
+    bool checkpointed;
+
+    // constructor that builds an unlimited budget
+    MemoryBudget();
+
+    // records the specified usage and returns whether it exceeds the budget
+    bool update(const MemoryUsage& usage);
+};
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
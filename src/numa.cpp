@@ -0,0 +1,76 @@
+/* ---------------------------------------------------------------------- *
+ * numa.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "numa.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+
+#include <pthread.h>
+#include <sched.h>
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the numa topology
+ * ---------------------------------------------------------------------- */
+
+int NumaTopology::node_count() const {
+    return (int) nodes.size();
+}
+
+void detect_numa_topology(NumaTopology& topology) {
+    topology.nodes.clear();
+
+    // nodes are numbered consecutively on all but exotic machines
+    for (int node = 0; ; ++node) {
+        std::ostringstream path;
+        path << "/sys/devices/system/node/node" << node << "/cpulist";
+        std::ifstream input_stream(path.str().c_str());
+        std::string text;
+        if (!input_stream || !std::getline(input_stream, text)) { break; }
+
+        std::vector<int> cpus;
+        if (!parse_cpu_list(text, cpus)) { break; }
+
+        // nodes without cpus only provide memory
+        if (!cpus.empty()) { topology.nodes.push_back(cpus); }
+    }
+
+    if (topology.nodes.empty()) { topology.nodes.push_back(std::vector<int>()); }
+}
+
+bool parse_cpu_list(const std::string& text, std::vector<int>& cpus) {
+    cpus.clear();
+    std::istringstream input_stream(text);
+    std::string range;
+    while (std::getline(input_stream, range, ',')) {
+        if (range.empty()) { continue; }
+        char* end;
+        long first = std::strtol(range.c_str(), &end, 10);
+        long last = first;
+        if (end == range.c_str()) { return false; }
+        if (*end == '-') {
+            const char* begin = end + 1;
+            last = std::strtol(begin, &end, 10);
+            if (end == begin) { return false; }
+        }
+        if (*end != '\0' || first < 0 || last < first) { return false; }
+        for (long cpu = first; cpu <= last; ++cpu) { cpus.push_back((int) cpu); }
+    }
+    return true;
+}
+
+bool pin_thread(const std::vector<int>& cpus) {
+    if (cpus.empty()) { return false; }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        if (cpus[i] < CPU_SETSIZE) { CPU_SET(cpus[i], &set); }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
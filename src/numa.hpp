@@ -0,0 +1,42 @@
+/* ---------------------------------------------------------------------- *
+ * numa.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_NUMA__
+#define __FG_NUMA__
+
+#include <vector>
+#include <string>
+
+/* ---------------------------------------------------------------------- *
+ * numa topology
+ *
+ * the nodes and their cpus are read from /sys/devices/system/node. if the
+ * directory does not exist, the machine is treated as a single node whose
+ * cpus are unknown.
+ * ---------------------------------------------------------------------- */
+
+struct NumaTopology {
+    // the cpus of every node
+    std::vector<std::vector<int> > nodes;
+
+    // returns the number of nodes
+    int node_count() const;
+};
+
+// detects the numa topology of this machine
+void detect_numa_topology(NumaTopology& topology);
+
+// parses a list of cpus such as "0-3,8-11". returns false if the
+// specified text is not a list of cpus
+bool parse_cpu_list(const std::string& text, std::vector<int>& cpus);
+
+// pins the calling thread to the specified cpus. returns false if the
+// thread cannot be pinned
+bool pin_thread(const std::vector<int>& cpus);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,129 @@
+/* ---------------------------------------------------------------------- *
+ * ordering.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "ordering.hpp"
+
+#include <algorithm>
+
+/* ---------------------------------------------------------------------- *
+ * helper functions
+ * ---------------------------------------------------------------------- */
+
+namespace {
+
+// compares vertices by degree and breaks ties by index
+struct DegreeLess {
+    const CsrGraph& graph;
+
+    DegreeLess(const CsrGraph& graph) : graph(graph) {}
+
+    bool operator ()(int a, int b) const {
+        int degree_a = graph.degree(a);
+        int degree_b = graph.degree(b);
+        return degree_a < degree_b || (degree_a == degree_b && a < b);
+    }
+};
+
+}
+
+/* ---------------------------------------------------------------------- *
+ * vertex orders
+ * ---------------------------------------------------------------------- */
+
+bool parse_vertex_order(const std::string& name, VertexOrder& order) {
+    if (name == "discovery") { order = ORDER_DISCOVERY; return true; }
+    if (name == "rcm") { order = ORDER_RCM; return true; }
+    if (name == "degree") { order = ORDER_DEGREE; return true; }
+    if (name == "code") { order = ORDER_CODE; return true; }
+    return false;
+}
+
+void compute_rcm_order(const CsrGraph& graph, std::vector<int>& order) {
+    int n = graph.order();
+    DegreeLess less(graph);
+    std::vector<bool> visited(n, false);
+    std::vector<int> vertices(n);
+    std::vector<int> neighbors;
+    order.clear();
+    order.reserve(n);
+
+    // every component is started at a vertex of minimum degree
+    for (int i = 0; i < n; ++i) { vertices[i] = i; }
+    std::sort(vertices.begin(), vertices.end(), less);
+
+    for (int i = 0; i < n; ++i) {
+        int start = vertices[i];
+        if (visited[start]) { continue; }
+
+        // cuthill-mckee: bfs that visits neighbors by increasing degree.
+        // the order itself serves as the queue
+        int head = (int) order.size();
+        visited[start] = true;
+        order.push_back(start);
+        while (head < (int) order.size()) {
+            int index = order[head++];
+            int degree = graph.degree(index);
+            const int* adjacent = graph.neighbors(index);
+
+            neighbors.clear();
+            for (int j = 0; j < degree; ++j) {
+                if (!visited[adjacent[j]]) {
+                    visited[adjacent[j]] = true;
+                    neighbors.push_back(adjacent[j]);
+                }
+            }
+            std::sort(neighbors.begin(), neighbors.end(), less);
+            order.insert(order.end(), neighbors.begin(), neighbors.end());
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+}
+
+void compute_degree_order(const CsrGraph& graph, std::vector<int>& order) {
+    int n = graph.order();
+    order.resize(n);
+    for (int i = 0; i < n; ++i) { order[i] = i; }
+    std::sort(order.begin(), order.end(), DegreeLess(graph));
+    std::reverse(order.begin(), order.end());
+}
+
+/* ---------------------------------------------------------------------- *
+ * relabeling
+ * ---------------------------------------------------------------------- */
+
+void relabel_graph(const CsrGraph& graph, const std::vector<int>& order, CsrGraph& result) {
+    int n = graph.order();
+    std::vector<int> labels(n);
+    for (int i = 0; i < n; ++i) { labels[order[i]] = i; }
+
+    result.clear();
+    GraphBuilder builder(result);
+    for (int i = 0; i < n; ++i) {
+        int index = order[i];
+        int degree = graph.degree(index);
+        const int* neighbors = graph.neighbors(index);
+        for (int j = 0; j < degree; ++j) { builder.add_neighbor(labels[neighbors[j]]); }
+        builder.finish_vertex();
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * write functions
+ * ---------------------------------------------------------------------- */
+
+void write_order(const std::vector<int>& order, const std::vector<unsigned char>& codes, int length,
+                 std::ostream& output_stream) {
+    int n = (int) order.size();
+    for (int i = 0; i < n; ++i) {
+        const unsigned char* symbols = codes.data() + (size_t) order[i] * length;
+        output_stream << i << ":";
+        for (int j = 0; j < length; ++j) { output_stream << " " << (int) symbols[j]; }
+        output_stream << "\n";
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,45 @@
+/* ---------------------------------------------------------------------- *
+ * ordering.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_ORDERING__
+#define __FG_ORDERING__
+
+#include "graph.hpp"
+
+#include <vector>
+#include <string>
+#include <iostream>
+
+// the vertex orders a flip graph can be relabeled with. an order is given
+// as a list that contains at position i the old index of the new i-th vertex
+enum VertexOrder {
+    ORDER_DISCOVERY,
+    ORDER_RCM,
+    ORDER_DEGREE,
+    ORDER_CODE
+};
+
+// returns the vertex order with the specified name or false if it does not exist
+bool parse_vertex_order(const std::string& name, VertexOrder& order);
+
+// computes the reverse cuthill-mckee order of the specified graph
+void compute_rcm_order(const CsrGraph& graph, std::vector<int>& order);
+
+// computes the order of the specified graph by decreasing degree
+void compute_degree_order(const CsrGraph& graph, std::vector<int>& order);
+
+// relabels the specified graph according to the specified order
+void relabel_graph(const CsrGraph& graph, const std::vector<int>& order, CsrGraph& result);
+
+// writes the code of every vertex of the output to the specified stream.
+// the i-th vertex of the output is the vertex order[i] of the search and
+// its code starts at order[i] times the specified length
+void write_order(const std::vector<int>& order, const std::vector<unsigned char>& codes, int length,
+                 std::ostream& output_stream);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,270 @@
+/* ---------------------------------------------------------------------- *
+ * parallel.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "parallel.hpp"
+#include "triangulation.hpp"
+#include "code_batch.hpp"
+#include "code_table.hpp"
+
+#include <atomic>
+#include <algorithm>
+#include <unordered_set>
+#include <cstring>
+
+/* ---------------------------------------------------------------------- *
+ * parallel flip graph
+ *
+ * the bfs proceeds layer by layer. all triangulations of the next layer
+ * are discovered while the current layer is expanded, hence the indices of
+ * every layer are consecutive and a layer is represented by a range of
+ * indices. the codes themselves are kept in a shared code table.
+ *
+ * a layer is split into chunks of consecutive indices which are the tasks
+ * of the work-stealing scheduler. what is done with the neighbors of every
+ * triangulation is up to a consumer that is notified about every layer and
+ * every chunk. the memory of a layer is the code table, which is allocated
+ * up front, and whatever the consumer keeps until the layer is finished.
+ * ---------------------------------------------------------------------- */
+
+namespace {
+
+// the number of triangulations per chunk
+const int chunk_size = 64;
+
+// compares indices by the codes stored in a code table
+struct CodeLess {
+    const CodeTable& table;
+
+    CodeLess(const CodeTable& table) : table(table) {}
+
+    bool operator ()(int a, int b) const {
+        return std::memcmp(table.code(a), table.code(b), table.length()) < 0;
+    }
+};
+
+// the scratch space of a thread
+struct Worker {
+    CodeBatch batch;
+    std::vector<Edge*> edges;
+    std::vector<Code> codes;
+    std::vector<int> neighbors;
+
+    // the fingerprint of the expanded triangulation if it is computed
+    bool fingerprinted;
+    uint64_t fingerprint;
+};
+
+// computes the sorted indices of the accepted neighbors of the
+// triangulation with the specified index. returns false if the code table
+// is full
+bool expand(CodeTable& table, int index, const Predicate* predicate, Worker& worker) {
+    Triangulation triangulation(Code(table.code(index), table.length()));
+    if (worker.fingerprinted) { worker.fingerprint = triangulation.fingerprint(); }
+
+    collect_flips(triangulation, predicate, worker.edges);
+    worker.batch.compute_codes(triangulation, worker.edges, worker.codes);
+
+    worker.neighbors.clear();
+    int k = (int) worker.edges.size();
+    for (int i = 0; i < k; ++i) {
+        bool inserted;
+        int other_index = table.insert(worker.codes[i].symbols(), inserted);
+        if (other_index < 0) { return false; }
+        worker.neighbors.push_back(other_index);
+    }
+
+    std::sort(worker.neighbors.begin(), worker.neighbors.end());
+    worker.neighbors.erase(std::unique(worker.neighbors.begin(), worker.neighbors.end()),
+                           worker.neighbors.end());
+    return true;
+}
+
+// explores the flip graph on all triangulations with n vertices that are
+// accepted by the specified predicate, starting at the start triangulations.
+// before a layer is expanded, the consumer's begin_layer is called with the
+// number of triangulations and chunks of the layer. consume is called with
+// the thread, the chunk, the index and the worker of every expanded
+// triangulation and end_layer is called once the layer is finished. if a
+// budget is specified, the usage is recorded after every layer. returns
+// false if the number of triangulations is not known or the code table is
+// full
+template <class Consumer>
+bool explore(int n, Scheduler& scheduler, const Predicate* predicate, Consumer& consumer, CodeTable*& table,
+             MemoryBudget* budget) {
+    long long capacity = triangulation_count(n);
+    if (capacity < 0) { return false; }
+
+    // add start triangulations
+    std::vector<Code> starts;
+    find_start_codes(n, predicate, starts);
+    table = new CodeTable(7 * n - 11, capacity);
+    for (size_t i = 0; i < starts.size(); ++i) {
+        bool inserted;
+        table->insert(starts[i].symbols(), inserted);
+    }
+
+    std::vector<Worker> workers(scheduler.threads());
+    for (size_t t = 0; t < workers.size(); ++t) { workers[t].fingerprinted = consumer.fingerprinted; }
+    std::atomic<bool> failed(false);
+    int begin = 0;
+    int end = table->size();
+    while (begin < end) {
+        int chunks = (end - begin + chunk_size - 1) / chunk_size;
+        consumer.begin_layer(end - begin, chunks);
+        scheduler.run(chunks, [&](int thread, int chunk) {
+            int first = begin + chunk * chunk_size;
+            int last = std::min(end, first + chunk_size);
+            for (int index = first; index < last; ++index) {
+                if (!expand(*table, index, predicate, workers[thread])) { failed = true; return; }
+                consumer.consume(thread, chunk, index, workers[thread]);
+            }
+        });
+        if (failed) { return false; }
+        consumer.end_layer();
+
+        // the codes are stored in the arena of the table
+        if (budget) {
+            MemoryUsage usage;
+            usage.index = table->memory();
+            consumer.account(usage);
+            budget->update(usage);
+            if (budget->progress) {
+                *budget->progress << "expanded: " << end << ", discovered: " << table->size() << ", ";
+                write_memory_usage(usage, *budget->progress);
+            }
+        }
+
+        begin = end;
+        end = table->size();
+    }
+
+    return true;
+}
+
+// appends the neighbors of every chunk to a csr graph of its own. the
+// chunks are passed to the builder in order
+struct GraphConsumer {
+    GraphBuilder& builder;
+    std::vector<CsrGraph> pieces;
+    bool fingerprinted;
+
+    GraphConsumer(GraphBuilder& builder) : builder(builder), fingerprinted(false) {}
+
+    void begin_layer(int, int chunks) {
+        pieces.clear();
+        pieces.resize(chunks);
+    }
+
+    void consume(int, int chunk, int, const Worker& worker) {
+        GraphBuilder builder(pieces[chunk]);
+        int degree = (int) worker.neighbors.size();
+        for (int i = 0; i < degree; ++i) { builder.add_neighbor(worker.neighbors[i]); }
+        builder.finish_vertex();
+    }
+
+    void end_layer() {
+        int chunks = (int) pieces.size();
+        for (int c = 0; c < chunks; ++c) {
+            const CsrGraph& piece = pieces[c];
+            for (int i = 0; i < piece.order(); ++i) {
+                const int* neighbors = piece.neighbors(i);
+                for (int j = 0; j < piece.degree(i); ++j) { builder.add_neighbor(neighbors[j]); }
+                builder.finish_vertex();
+            }
+        }
+    }
+
+    void account(MemoryUsage& usage) const {
+        for (size_t c = 0; c < pieces.size(); ++c) { usage.frontier += pieces[c].memory(); }
+        usage.adjacency = builder.memory();
+    }
+};
+
+// counts the degrees in statistics of every thread and, for small n, collects
+// the distinct fingerprints of every thread
+struct StatisticsConsumer {
+    FlipGraphStatistics& statistics;
+    std::vector<FlipGraphStatistics> threads;
+    std::vector<std::unordered_set<uint64_t> > fingerprints;
+    bool fingerprinted;
+
+    StatisticsConsumer(FlipGraphStatistics& statistics, int threads)
+        : statistics(statistics), threads(threads), fingerprints(threads),
+          fingerprinted(statistics.n <= max_fingerprinted_order) {}
+
+    void begin_layer(int size, int) {
+        statistics.layers.push_back(size);
+    }
+
+    void consume(int thread, int, int index, const Worker& worker) {
+        int degree = (int) worker.neighbors.size();
+        int loops = std::binary_search(worker.neighbors.begin(), worker.neighbors.end(), index) ? 1 : 0;
+        threads[thread].add_vertex(degree, loops);
+        if (fingerprinted) { fingerprints[thread].insert(worker.fingerprint); }
+    }
+
+    void end_layer() {}
+
+    void account(MemoryUsage& usage) const {
+        // a set node holds a pointer besides its value
+        for (size_t t = 0; t < fingerprints.size(); ++t) {
+            usage.frontier += (long long) fingerprints[t].size() * heap_block(sizeof(void*) + sizeof(uint64_t))
+                            + (long long) fingerprints[t].bucket_count() * sizeof(void*);
+        }
+    }
+};
+
+}
+
+bool compute_flip_graph_parallel(int n, Scheduler& scheduler, CsrGraph& graph, std::vector<int>& code_order,
+                                 const Predicate* predicate) {
+    graph.clear();
+    GraphBuilder builder(graph);
+    return compute_flip_graph_parallel(n, scheduler, builder, code_order, predicate);
+}
+
+bool compute_flip_graph_parallel(int n, Scheduler& scheduler, GraphBuilder& builder, std::vector<int>& code_order,
+                                 const Predicate* predicate, MemoryBudget* budget) {
+    CodeTable* table = 0;
+    GraphConsumer consumer(builder);
+
+    bool success = explore(n, scheduler, predicate, consumer, table, budget);
+    if (success) {
+        code_order.resize(table->size());
+        for (int i = 0; i < table->size(); ++i) {
+            code_order[i] = i;
+            builder.set_code(i, table->code(i), table->length());
+        }
+        std::sort(code_order.begin(), code_order.end(), CodeLess(*table));
+    }
+
+    delete table;
+    return success;
+}
+
+bool compute_flip_graph_statistics_parallel(int n, Scheduler& scheduler, FlipGraphStatistics& statistics,
+                                            const Predicate* predicate) {
+    statistics = FlipGraphStatistics();
+    statistics.n = n;
+    CodeTable* table = 0;
+    StatisticsConsumer consumer(statistics, scheduler.threads());
+
+    bool success = explore(n, scheduler, predicate, consumer, table, 0);
+    if (success) {
+        std::unordered_set<uint64_t>& fingerprints = consumer.fingerprints[0];
+        for (int t = 0; t < scheduler.threads(); ++t) {
+            statistics.add_vertices(consumer.threads[t]);
+            if (t > 0) { fingerprints.insert(consumer.fingerprints[t].begin(), consumer.fingerprints[t].end()); }
+        }
+        if (consumer.fingerprinted) { statistics.fingerprints = (long long) fingerprints.size(); }
+        statistics.scheduler = scheduler.statistics();
+    }
+
+    delete table;
+    return success;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
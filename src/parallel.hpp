@@ -0,0 +1,43 @@
+/* ---------------------------------------------------------------------- *
+ * parallel.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_PARALLEL__
+#define __FG_PARALLEL__
+
+#include "graph.hpp"
+#include "scheduler.hpp"
+#include "statistics.hpp"
+#include "predicate.hpp"
+#include "memory.hpp"
+
+#include <vector>
+
+// computes the flip graph on all triangulations with n vertices and the
+// indices of its vertices ordered by code using the specified scheduler.
+// a predicate restricts the search like it does for compute_flip_graph.
+// returns false if the number of triangulations is not known
+bool compute_flip_graph_parallel(int n, Scheduler& scheduler, CsrGraph& graph, std::vector<int>& code_order,
+                                 const Predicate* predicate = 0);
+
+// computes the flip graph on all triangulations with n vertices and the
+// indices of its vertices ordered by code using the specified scheduler.
+// the vertices are passed to the specified builder in the order of their
+// indices once their layer is finished. if a budget is specified, the
+// memory is accounted after every layer and progress is written to the
+// stream of the budget. the limit of the budget is not enforced. returns
+// false if the number of triangulations is not known
+bool compute_flip_graph_parallel(int n, Scheduler& scheduler, GraphBuilder& builder, std::vector<int>& code_order,
+                                 const Predicate* predicate = 0, MemoryBudget* budget = 0);
+
+// computes the statistics of the flip graph on all triangulations with n
+// vertices without storing its edges using the specified scheduler.
+// returns false if the number of triangulations is not known
+bool compute_flip_graph_statistics_parallel(int n, Scheduler& scheduler, FlipGraphStatistics& statistics,
+                                            const Predicate* predicate = 0);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
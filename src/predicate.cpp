@@ -0,0 +1,265 @@
+/* ---------------------------------------------------------------------- *
+ * predicate.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "predicate.hpp"
+
+#include <random>
+#include <algorithm>
+
+/* ---------------------------------------------------------------------- *
+ * helper functions
+ * ---------------------------------------------------------------------- */
+
+namespace {
+
+// the maximum number of flips tried while looking for a start triangulation
+const long long max_start_steps = 1000000;
+
+// returns the number of common neighbors of the specified vertices
+int common_neighbors(Vertex* vertex_a, Vertex* vertex_b) {
+    int count = 0;
+    Edge* first_a = vertex_a->edge();
+    Edge* current_a = first_a;
+    do {
+        Vertex* vertex = current_a->target();
+        Edge* first_b = vertex_b->edge();
+        Edge* current_b = first_b;
+        do {
+            if (current_b->target() == vertex) { count++; break; }
+            current_b = current_b->twin()->next();
+        } while (current_b != first_b);
+        current_a = current_a->twin()->next();
+    } while (current_a != first_a);
+    return count;
+}
+
+}
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the predicate classes
+ * ---------------------------------------------------------------------- */
+
+Predicate::~Predicate() {}
+
+bool Predicate::admits(int n) const {
+    return n >= 4;
+}
+
+bool Predicate::accepts_flip(const Triangulation& triangulation, Edge*) const {
+    return accepts(triangulation);
+}
+
+int Predicate::violations(const Triangulation& triangulation) const {
+    return accepts(triangulation) ? 0 : 1;
+}
+
+MinDegreePredicate::MinDegreePredicate(int degree) : degree_(degree) {}
+
+bool MinDegreePredicate::accepts(const Triangulation& triangulation) const {
+    int n = triangulation.order();
+    for (int i = 0; i < n; ++i) {
+        if (triangulation.vertex(i)->degree() < degree_) { return false; }
+    }
+    return true;
+}
+
+bool MinDegreePredicate::admits(int n) const {
+    // every triangulation has a vertex of degree at most five, minimum
+    // degree four requires six and minimum degree five twelve vertices but
+    // is impossible with thirteen
+    if (n < 4) { return false; }
+    if (degree_ <= 3) { return true; }
+    if (degree_ == 4) { return n >= 6; }
+    if (degree_ == 5) { return n == 12 || n >= 14; }
+    return false;
+}
+
+bool MinDegreePredicate::accepts_flip(const Triangulation&, Edge* edge) const {
+    // only the endpoints of the removed edge lost a neighbor
+    return edge->next()->target()->degree() >= degree_
+        && edge->twin()->next()->target()->degree() >= degree_;
+}
+
+int MinDegreePredicate::violations(const Triangulation& triangulation) const {
+    // the number of missing neighbors
+    int count = 0;
+    int n = triangulation.order();
+    for (int i = 0; i < n; ++i) { count += std::max(0, degree_ - triangulation.vertex(i)->degree()); }
+    return count;
+}
+
+MaxDegreePredicate::MaxDegreePredicate(int degree) : degree_(degree) {}
+
+bool MaxDegreePredicate::accepts(const Triangulation& triangulation) const {
+    int n = triangulation.order();
+    for (int i = 0; i < n; ++i) {
+        if (triangulation.vertex(i)->degree() > degree_) { return false; }
+    }
+    return true;
+}
+
+bool MaxDegreePredicate::admits(int n) const {
+    // the degrees sum up to 6n - 12
+    return n >= 4 && (long long) degree_ * n >= 6LL * n - 12;
+}
+
+bool MaxDegreePredicate::accepts_flip(const Triangulation&, Edge* edge) const {
+    // only the endpoints of the inserted edge gained a neighbor
+    return edge->target()->degree() <= degree_ && edge->twin()->target()->degree() <= degree_;
+}
+
+int MaxDegreePredicate::violations(const Triangulation& triangulation) const {
+    // the number of excess neighbors
+    int count = 0;
+    int n = triangulation.order();
+    for (int i = 0; i < n; ++i) { count += std::max(0, triangulation.vertex(i)->degree() - degree_); }
+    return count;
+}
+
+bool SeparatingTrianglePredicate::accepts(const Triangulation& triangulation) const {
+    // every edge lies on two faces, any further common neighbor of its
+    // endpoints closes a separating triangle
+    int m = triangulation.size();
+    for (int i = 0; i < m; ++i) {
+        Edge* edge = triangulation.edge(i);
+        if (edge < edge->twin() && common_neighbors(edge->target(), edge->twin()->target()) > 2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SeparatingTrianglePredicate::admits(int n) const {
+    // the triangulation with five vertices has two vertices of degree three
+    return n >= 4 && n != 5;
+}
+
+bool SeparatingTrianglePredicate::accepts_flip(const Triangulation&, Edge* edge) const {
+    // a flip can only create triangles that contain the inserted edge
+    return common_neighbors(edge->target(), edge->twin()->target()) <= 2;
+}
+
+int SeparatingTrianglePredicate::violations(const Triangulation& triangulation) const {
+    // the number of separating triangles, counted once for each of their edges
+    int count = 0;
+    int m = triangulation.size();
+    for (int i = 0; i < m; ++i) {
+        Edge* edge = triangulation.edge(i);
+        if (edge < edge->twin()) { count += common_neighbors(edge->target(), edge->twin()->target()) - 2; }
+    }
+    return count;
+}
+
+PredicateList::~PredicateList() {
+    for (size_t i = 0; i < predicates_.size(); ++i) { delete predicates_[i]; }
+}
+
+void PredicateList::add(Predicate* predicate) {
+    predicates_.push_back(predicate);
+}
+
+bool PredicateList::empty() const {
+    return predicates_.empty();
+}
+
+bool PredicateList::accepts(const Triangulation& triangulation) const {
+    for (size_t i = 0; i < predicates_.size(); ++i) {
+        if (!predicates_[i]->accepts(triangulation)) { return false; }
+    }
+    return true;
+}
+
+bool PredicateList::admits(int n) const {
+    for (size_t i = 0; i < predicates_.size(); ++i) {
+        if (!predicates_[i]->admits(n)) { return false; }
+    }
+    return true;
+}
+
+bool PredicateList::accepts_flip(const Triangulation& triangulation, Edge* edge) const {
+    for (size_t i = 0; i < predicates_.size(); ++i) {
+        if (!predicates_[i]->accepts_flip(triangulation, edge)) { return false; }
+    }
+    return true;
+}
+
+int PredicateList::violations(const Triangulation& triangulation) const {
+    int count = 0;
+    for (size_t i = 0; i < predicates_.size(); ++i) { count += predicates_[i]->violations(triangulation); }
+    return count;
+}
+
+/* ---------------------------------------------------------------------- *
+ * function definitions
+ * ---------------------------------------------------------------------- */
+
+void collect_flips(Triangulation& triangulation, const Predicate* predicate, std::vector<Edge*>& edges) {
+    edges.clear();
+    int m = triangulation.size();
+    for (int i = 0; i < m; ++i) {
+        Edge* edge = triangulation.edge(i);
+        if (!triangulation.is_representative(edge) || !triangulation.is_flippable(edge)) { continue; }
+        if (predicate) {
+            triangulation.flip(edge);
+            bool accepted = predicate->accepts_flip(triangulation, edge);
+            triangulation.flip(edge);
+            if (!accepted) { continue; }
+        }
+        edges.push_back(edge);
+    }
+}
+
+bool find_start_codes(int n, const Predicate* predicate, std::vector<Code>& starts) {
+    starts.clear();
+    Triangulation triangulation(n);
+    if (!predicate) {
+        starts.push_back(Code(triangulation));
+        return true;
+    }
+    if (!predicate->admits(n)) { return false; }
+
+    // flips that keep the violations are taken as well, so the walk may
+    // cross plateaus. the seed only depends on n so runs are reproducible
+    std::mt19937 random(n);
+    std::vector<Edge*> edges;
+    std::vector<Code> isolated;
+    int m = triangulation.size();
+    int violations = predicate->violations(triangulation);
+    for (long long step = 0; step < max_start_steps; ++step) {
+        if (violations == 0) {
+            collect_flips(triangulation, predicate, edges);
+            if (!edges.empty()) {
+                starts.push_back(Code(triangulation));
+                return true;
+            }
+
+            // every flip of an isolated triangulation increases the
+            // violations, hence the walk is restarted from a random one
+            if (isolated.empty()) { isolated.push_back(Code(triangulation)); }
+            for (int i = 0; i < m; ++i) {
+                Edge* edge = triangulation.edge((int) (random() % m));
+                if (triangulation.is_flippable(edge)) { triangulation.flip(edge); }
+            }
+            violations = predicate->violations(triangulation);
+            continue;
+        }
+
+        Edge* edge = triangulation.edge((int) (random() % m));
+        if (!triangulation.is_flippable(edge)) { continue; }
+        triangulation.flip(edge);
+        int flipped = predicate->violations(triangulation);
+        if (flipped <= violations) {
+            violations = flipped;
+        } else {
+            triangulation.flip(edge);
+        }
+    }
+
+    starts = isolated;
+    return !starts.empty();
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,135 @@
+/* ---------------------------------------------------------------------- *
+ * predicate.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_PREDICATE__
+#define __FG_PREDICATE__
+
+#include "triangulation.hpp"
+
+#include <vector>
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the predicate classes
+ *
+ * a predicate restricts the search to the triangulations it accepts. it is
+ * evaluated on every flipped triangulation before its code is computed.
+ * since every triangulation that is expanded was accepted, a predicate may
+ * only look at the part of the triangulation that was changed by the flip.
+ *
+ * the search starts from an accepted triangulation that is found by random
+ * flips that do not increase the violations of the predicate, so only the
+ * component of the restricted flip graph that contains it is explored.
+ * ---------------------------------------------------------------------- */
+
+class Predicate {
+public:
+    // destructor
+    virtual ~Predicate();
+
+    // returns whether the specified triangulation is accepted
+    virtual bool accepts(const Triangulation& triangulation) const = 0;
+
+    // returns false if no triangulation with n vertices is accepted. a
+    // predicate may return true although it accepts none of them
+    virtual bool admits(int n) const;
+
+    // returns whether the specified triangulation is accepted, given that
+    // it was obtained from an accepted triangulation by flipping the
+    // specified edge
+    virtual bool accepts_flip(const Triangulation& triangulation, Edge* edge) const;
+
+    // returns zero if the specified triangulation is accepted and otherwise
+    // a positive measure of how far it is from being accepted
+    virtual int violations(const Triangulation& triangulation) const;
+};
+
+// accepts triangulations whose vertices have at least the specified degree
+class MinDegreePredicate : public Predicate {
+public:
+    // constructor that builds the predicate for the specified degree
+    MinDegreePredicate(int degree);
+
+private:
+    // the minimum degree
+    int degree_;
+
+public:
+    bool accepts(const Triangulation& triangulation) const;
+    bool admits(int n) const;
+    bool accepts_flip(const Triangulation& triangulation, Edge* edge) const;
+    int violations(const Triangulation& triangulation) const;
+};
+
+// accepts triangulations whose vertices have at most the specified degree
+class MaxDegreePredicate : public Predicate {
+public:
+    // constructor that builds the predicate for the specified degree
+    MaxDegreePredicate(int degree);
+
+private:
+    // the maximum degree
+    int degree_;
+
+public:
+    bool accepts(const Triangulation& triangulation) const;
+    bool admits(int n) const;
+    bool accepts_flip(const Triangulation& triangulation, Edge* edge) const;
+    int violations(const Triangulation& triangulation) const;
+};
+
+// accepts triangulations without separating triangles, which are the
+// 4-connected triangulations on more than four vertices
+class SeparatingTrianglePredicate : public Predicate {
+public:
+    bool accepts(const Triangulation& triangulation) const;
+    bool admits(int n) const;
+    bool accepts_flip(const Triangulation& triangulation, Edge* edge) const;
+    int violations(const Triangulation& triangulation) const;
+};
+
+// accepts triangulations that are accepted by all of its predicates
+class PredicateList : public Predicate {
+public:
+    // destructor that deletes all predicates
+    ~PredicateList();
+
+private:
+    // the predicates
+    std::vector<Predicate*> predicates_;
+
+public:
+    // adds the specified predicate and takes ownership of it
+    void add(Predicate* predicate);
+
+    // returns whether the list is empty
+    bool empty() const;
+
+    bool accepts(const Triangulation& triangulation) const;
+    bool admits(int n) const;
+    bool accepts_flip(const Triangulation& triangulation, Edge* edge) const;
+    int violations(const Triangulation& triangulation) const;
+};
+
+/* ---------------------------------------------------------------------- *
+ * function declarations
+ * ---------------------------------------------------------------------- */
+
+// collects the representative flippable edges of the specified
+// triangulation whose flip is accepted by the specified predicate, which
+// may be 0. the triangulation is flipped back after every test
+void collect_flips(Triangulation& triangulation, const Predicate* predicate, std::vector<Edge*>& edges);
+
+// finds the codes of the triangulations with n vertices the search starts
+// from. without a predicate, this is the canonical triangulation. otherwise,
+// it is an accepted triangulation found by a seeded random walk from the
+// canonical triangulation that never increases the violations. accepted
+// triangulations without accepted flips are skipped unless no other one is
+// found. returns false if no accepted triangulation is found
+bool find_start_codes(int n, const Predicate* predicate, std::vector<Code>& starts);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,323 @@
+/* ---------------------------------------------------------------------- *
+ * reader.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "reader.hpp"
+#include "writer.hpp"
+#include "compression.hpp"
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* ---------------------------------------------------------------------- *
+ * chunks
+ *
+ * the file is split into chunks on line boundaries. every chunk is parsed
+ * by a thread of its own into the indices, degrees and neighbors of its
+ * lines, which are then copied to their place in the csr arrays.
+ * ---------------------------------------------------------------------- */
+
+namespace {
+
+struct Chunk {
+    // the characters of the chunk
+    const char* begin;
+    const char* end;
+
+    // the index, degree and neighbors of every line
+    std::vector<int> indices;
+    std::vector<int> degrees;
+    std::vector<int> neighbors;
+
+    // the largest index of any vertex in the chunk
+    int max_index;
+
+    // whether the chunk is well-formed
+    bool valid;
+};
+
+// parses the non-negative integer at the specified position. returns false
+// if there is none or it does not fit into an int
+inline bool parse_int(const char*& p, const char* end, int& value) {
+    if (p == end || *p < '0' || *p > '9') { return false; }
+    value = 0;
+    while (p != end && *p >= '0' && *p <= '9') {
+        int digit = *p++ - '0';
+        if (value > (INT_MAX - digit) / 10) { return false; }
+        value = 10 * value + digit;
+    }
+    return true;
+}
+
+// skips spaces, tabs and carriage returns
+inline void skip_blanks(const char*& p, const char* end) {
+    while (p != end && (*p == ' ' || *p == '\t' || *p == '\r')) { ++p; }
+}
+
+void parse_chunk(Chunk& chunk) {
+    const char* p = chunk.begin;
+    const char* end = chunk.end;
+    chunk.max_index = -1;
+    chunk.valid = false;
+
+    while (p != end) {
+        // skip empty lines
+        skip_blanks(p, end);
+        if (p != end && *p == '\n') { ++p; continue; }
+        if (p == end) { break; }
+
+        // line header "i:"
+        int index;
+        if (!parse_int(p, end, index)) { return; }
+        if (p == end || *p != ':') { return; }
+        ++p;
+
+        // neighbors
+        int degree = 0;
+        int neighbor;
+        skip_blanks(p, end);
+        while (p != end && *p != '\n') {
+            if (!parse_int(p, end, neighbor)) { return; }
+            chunk.neighbors.push_back(neighbor);
+            chunk.max_index = std::max(chunk.max_index, neighbor);
+            degree++;
+            skip_blanks(p, end);
+        }
+
+        chunk.indices.push_back(index);
+        chunk.degrees.push_back(degree);
+        chunk.max_index = std::max(chunk.max_index, index);
+    }
+
+    chunk.valid = true;
+}
+
+void copy_chunk(Chunk& chunk, const std::vector<int>& offsets, std::vector<int>& neighbors) {
+    int lines = (int) chunk.indices.size();
+    const int* source = chunk.neighbors.data();
+    for (int i = 0; i < lines; ++i) {
+        int degree = chunk.degrees[i];
+        std::memcpy(neighbors.data() + offsets[chunk.indices[i]], source, degree * sizeof(int));
+        source += degree;
+    }
+
+    // the chunk is no longer needed
+    std::vector<int>().swap(chunk.neighbors);
+}
+
+}
+
+/* ---------------------------------------------------------------------- *
+ * parse functions
+ * ---------------------------------------------------------------------- */
+
+namespace {
+
+// returns whether every neighbor is a vertex and the adjacency lists are
+// symmetric, where a loop appears once in the list of its vertex
+bool check_adjacency(const std::vector<int>& offsets, const std::vector<int>& neighbors) {
+    int n = (int) offsets.size() - 1;
+    for (size_t i = 0; i < neighbors.size(); ++i) {
+        if (neighbors[i] < 0 || neighbors[i] >= n) { return false; }
+    }
+
+    // the reversed lists are sorted since they are filled by increasing
+    // vertex. a list equals its reversed list once it is sorted as well
+    std::vector<int> reversed_offsets(n + 1, 0);
+    for (size_t i = 0; i < neighbors.size(); ++i) { reversed_offsets[neighbors[i] + 1]++; }
+    for (int i = 0; i < n; ++i) {
+        reversed_offsets[i + 1] += reversed_offsets[i];
+        if (reversed_offsets[i + 1] != offsets[i + 1]) { return false; }
+    }
+    std::vector<int> reversed(neighbors.size());
+    std::vector<int> positions(reversed_offsets.begin(), reversed_offsets.end() - 1);
+    for (int i = 0; i < n; ++i) {
+        for (int j = offsets[i]; j < offsets[i + 1]; ++j) { reversed[positions[neighbors[j]]++] = i; }
+    }
+
+    std::vector<int> list;
+    for (int i = 0; i < n; ++i) {
+        list.assign(neighbors.begin() + offsets[i], neighbors.begin() + offsets[i + 1]);
+        std::sort(list.begin(), list.end());
+        if (!std::equal(list.begin(), list.end(), reversed.begin() + offsets[i])) { return false; }
+    }
+    return true;
+}
+
+// parses the specified text using the specified number of threads
+bool parse_text(const char* data, size_t length, CsrGraph& graph, int threads) {
+    // split text into chunks on line boundaries
+    const char* data_end = data + length;
+    int count = (int) std::min<size_t>(4 * threads, length / 4096 + 1);
+    std::vector<Chunk> chunks(count);
+    const char* begin = data;
+    for (int i = 0; i < count; ++i) {
+        const char* end = (i + 1 == count) ? data_end : data + (length / count) * (i + 1);
+        if (end < begin) { end = begin; }
+        while (end != data_end && end != data && *(end - 1) != '\n') { ++end; }
+        chunks[i].begin = begin;
+        chunks[i].end = end;
+        begin = end;
+    }
+
+    // parse chunks in parallel
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&chunks, count, threads, t]() {
+            for (int i = t; i < count; i += threads) { parse_chunk(chunks[i]); }
+        }));
+    }
+    for (int t = 0; t < threads; ++t) { workers[t].join(); }
+    workers.clear();
+
+    // every line holds one vertex, hence all indices are below the number
+    // of lines and appear once
+    long long total = 0;
+    int max_index = -1;
+    for (int i = 0; i < count; ++i) {
+        if (!chunks[i].valid) { return false; }
+        total += (long long) chunks[i].indices.size();
+        max_index = std::max(max_index, chunks[i].max_index);
+    }
+    if (max_index >= total) { return false; }
+    int n = (int) total;
+
+    // compute offsets from the degrees
+    std::vector<int> degrees(n, -1);
+    for (int i = 0; i < count; ++i) {
+        int lines = (int) chunks[i].indices.size();
+        for (int j = 0; j < lines; ++j) {
+            int index = chunks[i].indices[j];
+            if (degrees[index] >= 0) { return false; }
+            degrees[index] = chunks[i].degrees[j];
+        }
+    }
+
+    std::vector<int> offsets(n + 1, 0);
+    for (int i = 0; i < n; ++i) { offsets[i + 1] = offsets[i] + std::max(degrees[i], 0); }
+
+    // copy adjacency lists in parallel
+    std::vector<int> neighbors(offsets[n]);
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&chunks, &offsets, &neighbors, count, threads, t]() {
+            for (int i = t; i < count; i += threads) { copy_chunk(chunks[i], offsets, neighbors); }
+        }));
+    }
+    for (int t = 0; t < threads; ++t) { workers[t].join(); }
+
+    if (!check_adjacency(offsets, neighbors)) { return false; }
+    graph.assign(offsets, neighbors);
+    return true;
+}
+
+// returns the 32-bit little-endian integer at the specified position
+inline int read_binary(const char* p) {
+    const unsigned char* q = (const unsigned char*) p;
+    return (int) ((uint32_t) q[0] | ((uint32_t) q[1] << 8) | ((uint32_t) q[2] << 16) | ((uint32_t) q[3] << 24));
+}
+
+// parses the specified records of the binary format. the records are read
+// twice, once for the degrees and once for the neighbors
+bool parse_binary(const char* data, size_t length, CsrGraph& graph) {
+    if (length % 4 != 0) { return false; }
+    size_t words = length / 4;
+
+    // collect degrees
+    std::vector<int> degrees;
+    size_t position = 0;
+    while (position < words) {
+        if (words - position < 2) { return false; }
+        int index = read_binary(data + 4 * position);
+        int degree = read_binary(data + 4 * position + 4);
+        if (index < 0 || degree < 0 || words - position - 2 < (size_t) degree) { return false; }
+
+        // every vertex takes at least two words
+        if ((size_t) index >= words / 2) { return false; }
+        if (index >= (int) degrees.size()) { degrees.resize(index + 1, -1); }
+        if (degrees[index] >= 0) { return false; }
+        degrees[index] = degree;
+        position += 2 + degree;
+    }
+
+    // every vertex needs a record
+    int n = (int) degrees.size();
+    std::vector<int> offsets(n + 1, 0);
+    for (int i = 0; i < n; ++i) {
+        if (degrees[i] < 0) { return false; }
+        offsets[i + 1] = offsets[i] + degrees[i];
+    }
+
+    // copy adjacency lists
+    std::vector<int> neighbors(offsets[n]);
+    position = 0;
+    while (position < words) {
+        int index = read_binary(data + 4 * position);
+        int degree = read_binary(data + 4 * position + 4);
+        const char* source = data + 4 * (position + 2);
+        for (int j = 0; j < degree; ++j) { neighbors[offsets[index] + j] = read_binary(source + 4 * j); }
+        position += 2 + degree;
+    }
+
+    if (!check_adjacency(offsets, neighbors)) { return false; }
+    graph.assign(offsets, neighbors);
+    return true;
+}
+
+// parses the specified data, which is either text or binary
+bool parse_graph(const char* data, size_t length, CsrGraph& graph, int threads) {
+    if (length >= 4 && std::memcmp(data, binary_magic, 4) == 0) {
+        return parse_binary(data + 4, length - 4, graph);
+    }
+    return parse_text(data, length, graph, threads);
+}
+
+}
+
+/* ---------------------------------------------------------------------- *
+ * read functions
+ * ---------------------------------------------------------------------- */
+
+bool read_flip_graph(const std::string& path, CsrGraph& graph, int threads) {
+    graph.clear();
+
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) { return false; }
+
+    struct stat status;
+    if (fstat(file, &status) != 0) { close(file); return false; }
+    size_t length = (size_t) status.st_size;
+    if (length == 0) { close(file); return true; }
+
+    void* mapping = mmap(0, length, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (mapping == MAP_FAILED) { return false; }
+    madvise(mapping, length, MADV_SEQUENTIAL);
+
+    const char* data = (const char*) mapping;
+    threads = std::max(1, threads);
+    bool result;
+    if (length >= 4 && std::memcmp(data, compression_magic, 4) == 0) {
+        // compressed streams are decompressed as a whole before parsing
+        std::vector<char> stream;
+        result = decompress_stream(data + 4, (long long) length - 4, stream);
+        munmap(mapping, length);
+        if (result) { result = parse_graph(stream.data(), stream.size(), graph, threads); }
+    } else {
+        result = parse_graph(data, length, graph, threads);
+        munmap(mapping, length);
+    }
+    return result;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
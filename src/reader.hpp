@@ -0,0 +1,22 @@
+/* ---------------------------------------------------------------------- *
+ * reader.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_READER__
+#define __FG_READER__
+
+#include "graph.hpp"
+
+#include <string>
+
+// reads the flip graph written by write_flip_graph or by a graph writer from
+// the specified file using the specified number of threads. text, binary and
+// compressed files are detected by their magic. returns false if the file
+// cannot be read or is malformed
+bool read_flip_graph(const std::string& path, CsrGraph& graph, int threads);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
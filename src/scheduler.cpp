@@ -0,0 +1,167 @@
+/* ---------------------------------------------------------------------- *
+ * scheduler.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "scheduler.hpp"
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the scheduler statistics
+ * ---------------------------------------------------------------------- */
+
+SchedulerStatistics::SchedulerStatistics(int threads)
+    : tasks(threads, 0), steals(threads, 0), idle(threads, 0.0), elapsed(0.0) {}
+
+void write_scheduler_statistics(const SchedulerStatistics& statistics, std::ostream& output_stream) {
+    int threads = (int) statistics.tasks.size();
+    long long tasks = 0;
+    long long steals = 0;
+    double idle = 0.0;
+    for (int t = 0; t < threads; ++t) {
+        tasks += statistics.tasks[t];
+        steals += statistics.steals[t];
+        idle += statistics.idle[t];
+    }
+
+    output_stream << "threads: " << threads << "\n";
+    output_stream << "tasks: " << tasks << "\n";
+    output_stream << "steals: " << steals << "\n";
+    output_stream << "elapsed: " << statistics.elapsed << " s\n";
+    output_stream << "idle: " << idle << " s";
+    if (statistics.elapsed > 0) {
+        output_stream << " (" << 100.0 * idle / (threads * statistics.elapsed) << "%)";
+    }
+    output_stream << "\n";
+    for (int t = 0; t < threads; ++t) {
+        output_stream << "thread " << t << ": " << statistics.tasks[t] << " tasks, "
+                      << statistics.steals[t] << " steals, " << statistics.idle[t] << " s idle\n";
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the scheduler class
+ * ---------------------------------------------------------------------- */
+
+Scheduler::Scheduler(int threads)
+    : threads_(threads < 1 ? 1 : threads), deques_(threads_), statistics_(threads_), task_(0),
+      generation_(0), running_(0), stopped_(false), finished_(threads_) {
+    for (int t = 1; t < threads_; ++t) { workers_.push_back(std::thread(&Scheduler::park, this, t)); }
+}
+
+Scheduler::~Scheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+        condition_.notify_all();
+    }
+    for (size_t i = 0; i < workers_.size(); ++i) { workers_[i].join(); }
+}
+
+bool Scheduler::next_task(int thread, int& task, bool& stolen) {
+    // take the next task of this thread
+    {
+        Deque& deque = deques_[thread];
+        std::lock_guard<std::mutex> lock(deque.mutex);
+        if (!deque.tasks.empty()) {
+            task = deque.tasks.front();
+            deque.tasks.pop_front();
+            stolen = false;
+            return true;
+        }
+    }
+
+    // steal the last task of another thread
+    for (int i = 1; i < threads_; ++i) {
+        Deque& deque = deques_[(thread + i) % threads_];
+        std::lock_guard<std::mutex> lock(deque.mutex);
+        if (!deque.tasks.empty()) {
+            task = deque.tasks.back();
+            deque.tasks.pop_back();
+            stolen = true;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Scheduler::work(int thread, const Task& task) {
+    // tasks are never added during a run, hence a thread that finds all
+    // deques empty is done. the time spent finding a task is idle time
+    int index;
+    bool stolen;
+    while (true) {
+        Clock::time_point start = Clock::now();
+        bool found = next_task(thread, index, stolen);
+        statistics_.idle[thread] += std::chrono::duration<double>(Clock::now() - start).count();
+        if (!found) { break; }
+
+        task(thread, index);
+        statistics_.tasks[thread]++;
+        if (stolen) { statistics_.steals[thread]++; }
+    }
+    finished_[thread] = Clock::now();
+}
+
+void Scheduler::park(int thread) {
+    long long generation = 0;
+    while (true) {
+        const Task* task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [&]() { return stopped_ || generation_ != generation; });
+            if (stopped_) { return; }
+            generation = generation_;
+            task = task_;
+        }
+
+        work(thread, *task);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--running_ == 0) { condition_.notify_all(); }
+    }
+}
+
+int Scheduler::threads() const {
+    return threads_;
+}
+
+void Scheduler::run(int count, const Task& task) {
+    Clock::time_point start = Clock::now();
+
+    // deal out contiguous blocks of tasks
+    for (int t = 0; t < threads_; ++t) {
+        int first = (int) ((long long) count * t / threads_);
+        int last = (int) ((long long) count * (t + 1) / threads_);
+        std::lock_guard<std::mutex> lock(deques_[t].mutex);
+        for (int i = first; i < last; ++i) { deques_[t].tasks.push_back(i); }
+    }
+
+    // wake the parked threads and work along
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        running_ = threads_ - 1;
+        generation_++;
+        condition_.notify_all();
+    }
+    work(0, task);
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this]() { return running_ == 0; });
+        task_ = 0;
+    }
+
+    Clock::time_point end = Clock::now();
+    for (int t = 0; t < threads_; ++t) {
+        statistics_.idle[t] += std::chrono::duration<double>(end - finished_[t]).count();
+    }
+    statistics_.elapsed += std::chrono::duration<double>(end - start).count();
+}
+
+const SchedulerStatistics& Scheduler::statistics() const {
+    return statistics_;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,136 @@
+/* ---------------------------------------------------------------------- *
+ * scheduler.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_SCHEDULER__
+#define __FG_SCHEDULER__
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the scheduler statistics
+ * ---------------------------------------------------------------------- */
+
+struct SchedulerStatistics {
+    // the number of tasks run by every thread
+    std::vector<long long> tasks;
+
+    // the number of tasks stolen by every thread
+    std::vector<long long> steals;
+
+    // the time in seconds every thread spent looking for tasks, including
+    // waiting for the locks of the deques and stealing, and waiting for the
+    // other threads at the end of a run
+    std::vector<double> idle;
+
+    // the total time in seconds spent in runs
+    double elapsed;
+
+    // constructor that builds empty statistics for the specified number of threads
+    SchedulerStatistics(int threads);
+};
+
+// writes the specified scheduler statistics to the specified stream
+void write_scheduler_statistics(const SchedulerStatistics& statistics, std::ostream& output_stream);
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the scheduler class
+ *
+ * runs a number of independent tasks on a fixed number of threads. the
+ * tasks are dealt out in contiguous blocks to one deque per thread. every
+ * thread takes tasks from the front of its own deque and, once that is
+ * empty, steals from the back of the deque of another thread. callers
+ * make tasks coarse by letting every task cover a chunk of work items.
+ * the threads other than the calling one are started once and parked on
+ * a condition variable between runs.
+ * ---------------------------------------------------------------------- */
+
+class Scheduler {
+public:
+    // the type of a task, called with the thread and the task index
+    typedef std::function<void(int, int)> Task;
+
+    // constructor that builds a scheduler for the specified number of
+    // threads and starts all but the first of them
+    Scheduler(int threads);
+
+    // destructor that stops the threads
+    ~Scheduler();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    // a deque of task indices
+    struct Deque {
+        std::mutex mutex;
+        std::deque<int> tasks;
+    };
+
+    // the number of threads
+    int threads_;
+
+    // the deque of every thread
+    std::vector<Deque> deques_;
+
+    // the statistics of all runs so far
+    SchedulerStatistics statistics_;
+
+    // the threads 1 to threads - 1
+    std::vector<std::thread> workers_;
+
+    // the mutex and condition guarding the fields below
+    std::mutex mutex_;
+    std::condition_variable condition_;
+
+    // the task of the current run
+    const Task* task_;
+
+    // the number of runs started so far
+    long long generation_;
+
+    // the number of threads that have not finished the current run
+    int running_;
+
+    // whether the threads have to exit
+    bool stopped_;
+
+    // the time every thread finished the current run
+    std::vector<Clock::time_point> finished_;
+
+    // takes a task from the specified thread's deque or steals one. returns
+    // false if all deques are empty
+    bool next_task(int thread, int& task, bool& stolen);
+
+    // runs the tasks of the specified thread until all deques are empty
+    void work(int thread, const Task& task);
+
+    // the loop of every thread but the first, which waits for runs
+    void park(int thread);
+
+    // copies the scheduler so copies are not possible
+    Scheduler(const Scheduler& scheduler);
+
+public:
+    // returns the number of threads
+    int threads() const;
+
+    // runs the tasks with indices 0 to count - 1 and returns once all of
+    // them are finished
+    void run(int count, const Task& task);
+
+    // returns the statistics of all runs so far
+    const SchedulerStatistics& statistics() const;
+};
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
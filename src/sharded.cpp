@@ -0,0 +1,411 @@
+/* ---------------------------------------------------------------------- *
+ * sharded.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "sharded.hpp"
+#include "numa.hpp"
+#include "triangulation.hpp"
+#include "code_batch.hpp"
+#include "code_table.hpp"
+#include "predicate.hpp"
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+/* ---------------------------------------------------------------------- *
+ * sharded flip graph
+ *
+ * the codes are partitioned into shards by a hash. on a numa machine every
+ * node holds one shard and the threads of a shard are pinned to its node.
+ * a shard's code table is allocated and first touched by its own threads,
+ * hence its index and its frontier live in the memory of its node. on a
+ * single node, every thread owns a shard of its own and nothing is pinned.
+ *
+ * the bfs proceeds layer by layer, and every layer takes two phases. in
+ * the first phase, the threads of every shard expand the frontier of their
+ * shard. the neighbor codes are collected in one batch per destination
+ * shard. in the second phase, the threads of every shard insert the
+ * batches addressed to their shard, so codes cross nodes only in batches.
+ * the new triangulations of a layer are numbered shard by shard.
+ * ---------------------------------------------------------------------- */
+
+namespace {
+
+// the number of triangulations per chunk of the frontier
+const int chunk_size = 64;
+
+// returns the shard of the specified code. the hash differs from the hash
+// of the code table, so the slots of every shard are used evenly
+int shard_of(const unsigned char* symbols, int length, int shards) {
+    uint64_t h = 0x84222325cbf29ce4ull;
+    for (int i = 0; i < length; ++i) {
+        h ^= symbols[i];
+        h *= 0x100000001b3ull;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return (int) ((h >> 16) % (uint64_t) shards);
+}
+
+// blocks threads until all of them arrived
+class Barrier {
+public:
+    Barrier(int threads) : threads_(threads), waiting_(0), generation_(0) {}
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        long long generation = generation_;
+        if (++waiting_ == threads_) {
+            waiting_ = 0;
+            generation_++;
+            condition_.notify_all();
+            return;
+        }
+        condition_.wait(lock, [&]() { return generation != generation_; });
+    }
+
+private:
+    int threads_;
+    int waiting_;
+    long long generation_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+};
+
+// the codes a thread forwards to one shard and the global indices of the
+// triangulations they were flipped from
+struct Batch {
+    std::vector<unsigned char> symbols;
+    std::vector<int> sources;
+};
+
+// the part of the index and the frontier that belongs to one shard
+struct Shard {
+    // the codes of the shard
+    CodeTable* table;
+
+    // the global index of every local index
+    std::vector<int> globals;
+
+    // the local indices of the frontier
+    int begin;
+    int end;
+};
+
+// the scratch space of a thread
+struct Worker {
+    CodeBatch batch;
+    std::vector<Edge*> edges;
+    std::vector<Code> codes;
+
+    // the batches to every shard
+    std::vector<Batch> outbox;
+
+    // pairs of source global index and local index in the thread's shard
+    std::vector<int> found;
+
+    // the number of codes forwarded within and across shards
+    long long local;
+    long long remote;
+};
+
+class ShardedSearch {
+public:
+    ShardedSearch(int n, int threads, int shards, GraphBuilder& builder, ShardStatistics& statistics);
+
+    // runs the search and returns false if a shard is full
+    bool run(std::vector<int>& code_order);
+
+private:
+    int length_;
+    int threads_;
+    int shard_count_;
+    long long capacity_;
+    bool pin_;
+    NumaTopology topology_;
+    GraphBuilder& builder_;
+    ShardStatistics& statistics_;
+
+    std::vector<Shard> shards_;
+    std::vector<Worker> workers_;
+    Barrier barrier_;
+    std::atomic<bool> failed_;
+    std::atomic<bool> unpinned_;
+
+    // the canonical code and its shard
+    Code canonical_;
+    int canonical_shard_;
+
+    // the global indices of the layer being expanded
+    int layer_begin_;
+    int layer_end_;
+
+    // the first global index of the new triangulations of every shard
+    std::vector<int> bases_;
+
+    // the end of the global indices of the new triangulations
+    int layer_next_;
+
+    // whether the last layer was expanded
+    bool done_;
+
+    // the loop of every thread
+    void work(int thread);
+
+    // expands the triangulation with the specified local index
+    void expand(const Shard& shard, int shard_index, int index, Worker& worker);
+
+    // numbers the new triangulations of all shards
+    void number_layer();
+
+    // passes the adjacency lists of the expanded layer to the builder
+    void write_layer();
+};
+
+ShardedSearch::ShardedSearch(int n, int threads, int shards, GraphBuilder& builder, ShardStatistics& statistics)
+    : threads_(threads), builder_(builder), statistics_(statistics), barrier_(threads),
+      failed_(false), unpinned_(false), canonical_(Triangulation(n)) {
+    detect_numa_topology(topology_);
+    int nodes = topology_.node_count();
+
+    // one shard per node or a plain partition on a single node. a forced
+    // number of shards is not pinned, every shard needs a thread
+    pin_ = shards <= 0 && nodes > 1 && threads > 1;
+    shard_count_ = pin_ ? std::min(nodes, threads) : threads;
+    if (shards > 0) { shard_count_ = std::min(shards, threads); }
+
+    // the shards hold about the same number of codes
+    long long count = triangulation_count(n);
+    capacity_ = count / shard_count_ + count / shard_count_ / 8 + 1024;
+
+    length_ = canonical_.length();
+    canonical_shard_ = shard_of(canonical_.symbols(), length_, shard_count_);
+    shards_.resize(shard_count_);
+    workers_.resize(threads_);
+    bases_.resize(shard_count_);
+    layer_begin_ = 0;
+    layer_end_ = 1;
+    done_ = false;
+
+    statistics_ = ShardStatistics();
+    statistics_.nodes = nodes;
+    statistics_.shards = shard_count_;
+}
+
+void ShardedSearch::expand(const Shard& shard, int shard_index, int index, Worker& worker) {
+    Triangulation triangulation(Code(shard.table->code(index), length_));
+    int source = shard.globals[index];
+
+    collect_flips(triangulation, 0, worker.edges);
+    worker.batch.compute_codes(triangulation, worker.edges, worker.codes);
+
+    int k = (int) worker.codes.size();
+    for (int i = 0; i < k; ++i) {
+        const unsigned char* symbols = worker.codes[i].symbols();
+        int target = shard_of(symbols, length_, shard_count_);
+        Batch& batch = worker.outbox[target];
+        batch.symbols.insert(batch.symbols.end(), symbols, symbols + length_);
+        batch.sources.push_back(source);
+        if (target == shard_index) { worker.local++; } else { worker.remote++; }
+    }
+}
+
+void ShardedSearch::number_layer() {
+    int next = layer_end_;
+    for (int s = 0; s < shard_count_; ++s) {
+        bases_[s] = next;
+        next += shards_[s].table->size() - shards_[s].end;
+    }
+    layer_next_ = next;
+    done_ = next == layer_end_;
+}
+
+void ShardedSearch::write_layer() {
+    int size = layer_end_ - layer_begin_;
+
+    // sort the found pairs by source with a counting sort
+    std::vector<int> offsets(size + 1, 0);
+    for (int t = 0; t < threads_; ++t) {
+        const std::vector<int>& found = workers_[t].found;
+        for (size_t j = 0; j < found.size(); j += 2) { offsets[found[j] - layer_begin_ + 1]++; }
+    }
+    for (int i = 0; i < size; ++i) { offsets[i + 1] += offsets[i]; }
+
+    std::vector<int> neighbors(offsets[size]);
+    std::vector<int> positions(offsets.begin(), offsets.end() - 1);
+    for (int t = 0; t < threads_; ++t) {
+        const std::vector<int>& found = workers_[t].found;
+        const std::vector<int>& globals = shards_[t % shard_count_].globals;
+        for (size_t j = 0; j < found.size(); j += 2) {
+            neighbors[positions[found[j] - layer_begin_]++] = globals[found[j + 1]];
+        }
+    }
+
+    for (int i = 0; i < size; ++i) {
+        for (int j = offsets[i]; j < offsets[i + 1]; ++j) { builder_.add_neighbor(neighbors[j]); }
+        builder_.finish_vertex();
+    }
+}
+
+void ShardedSearch::work(int thread) {
+    int shard_index = thread % shard_count_;
+    int rank = thread / shard_count_;
+    int members = (threads_ - shard_index + shard_count_ - 1) / shard_count_;
+    Shard& shard = shards_[shard_index];
+    Worker& worker = workers_[thread];
+
+    if (pin_ && !pin_thread(topology_.nodes[shard_index])) { unpinned_ = true; }
+
+    // the scratch space and the table are first touched on the node
+    worker.outbox.resize(shard_count_);
+    worker.local = 0;
+    worker.remote = 0;
+    if (rank == 0) {
+        shard.table = new CodeTable(length_, capacity_);
+        if (shard_index == canonical_shard_) {
+            bool inserted;
+            shard.table->insert(canonical_.symbols(), inserted);
+            shard.globals.push_back(0);
+        }
+        shard.begin = 0;
+        shard.end = shard.table->size();
+    }
+    barrier_.wait();
+
+    while (true) {
+        // expand the frontier of the shard
+        for (int s = 0; s < shard_count_; ++s) {
+            worker.outbox[s].symbols.clear();
+            worker.outbox[s].sources.clear();
+        }
+        for (int first = shard.begin + rank * chunk_size; first < shard.end; first += members * chunk_size) {
+            int last = std::min(shard.end, first + chunk_size);
+            for (int index = first; index < last; ++index) { expand(shard, shard_index, index, worker); }
+        }
+        barrier_.wait();
+
+        // insert the batches addressed to the shard
+        worker.found.clear();
+        for (int source = rank; source < threads_ && !failed_; source += members) {
+            const Batch& batch = workers_[source].outbox[shard_index];
+            int count = (int) batch.sources.size();
+            for (int j = 0; j < count; ++j) {
+                bool inserted;
+                int index = shard.table->insert(batch.symbols.data() + (size_t) j * length_, inserted);
+                if (index < 0) { failed_ = true; break; }
+                worker.found.push_back(batch.sources[j]);
+                worker.found.push_back(index);
+            }
+        }
+        barrier_.wait();
+        if (failed_) { break; }
+
+        // number the new triangulations
+        if (thread == 0) { number_layer(); }
+        barrier_.wait();
+
+        if (rank == 0) {
+            int size = shard.table->size();
+            for (int index = shard.end; index < size; ++index) {
+                shard.globals.push_back(bases_[shard_index] + index - shard.end);
+            }
+            shard.begin = shard.end;
+            shard.end = size;
+        }
+        barrier_.wait();
+
+        // pass the expanded layer on to the builder
+        if (thread == 0) {
+            write_layer();
+            layer_begin_ = layer_end_;
+            layer_end_ = layer_next_;
+        }
+        barrier_.wait();
+        if (done_) { break; }
+    }
+}
+
+bool ShardedSearch::run(std::vector<int>& code_order) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threads_; ++t) { threads.push_back(std::thread(&ShardedSearch::work, this, t)); }
+    for (int t = 0; t < threads_; ++t) { threads[t].join(); }
+
+    statistics_.pinned = pin_ && !unpinned_;
+    for (int t = 0; t < threads_; ++t) {
+        statistics_.local += workers_[t].local;
+        statistics_.remote += workers_[t].remote;
+    }
+
+    // order the global indices by code
+    bool success = !failed_;
+    int count = 0;
+    for (int s = 0; s < shard_count_; ++s) {
+        statistics_.vertices.push_back(shards_[s].table->size());
+        count += (int) shards_[s].globals.size();
+    }
+    code_order.clear();
+    if (success) {
+        std::vector<const unsigned char*> codes(count);
+        for (int s = 0; s < shard_count_; ++s) {
+            for (size_t i = 0; i < shards_[s].globals.size(); ++i) {
+                codes[shards_[s].globals[i]] = shards_[s].table->code((int) i);
+                builder_.set_code(shards_[s].globals[i], shards_[s].table->code((int) i), length_);
+            }
+        }
+        code_order.resize(count);
+        for (int i = 0; i < count; ++i) { code_order[i] = i; }
+        int length = length_;
+        std::sort(code_order.begin(), code_order.end(), [&codes, length](int a, int b) {
+            return std::memcmp(codes[a], codes[b], length) < 0;
+        });
+    }
+
+    for (int s = 0; s < shard_count_; ++s) { delete shards_[s].table; }
+    return success;
+}
+
+}
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the shard statistics
+ * ---------------------------------------------------------------------- */
+
+ShardStatistics::ShardStatistics() : nodes(0), shards(0), pinned(false), local(0), remote(0) {}
+
+void write_shard_statistics(const ShardStatistics& statistics, std::ostream& output_stream) {
+    output_stream << "numa nodes: " << statistics.nodes << "\n";
+    output_stream << "shards: " << statistics.shards << (statistics.pinned ? " (pinned)" : "") << "\n";
+    output_stream << "forwarded codes: " << statistics.local << " within shards, "
+                  << statistics.remote << " across shards\n";
+    for (size_t s = 0; s < statistics.vertices.size(); ++s) {
+        output_stream << "shard " << s << ": " << statistics.vertices[s] << " triangulations\n";
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * function definitions
+ * ---------------------------------------------------------------------- */
+
+bool compute_flip_graph_sharded(int n, int threads, CsrGraph& graph, std::vector<int>& code_order,
+                                ShardStatistics& statistics, int shards) {
+    graph.clear();
+    GraphBuilder builder(graph);
+    return compute_flip_graph_sharded(n, threads, builder, code_order, statistics, shards);
+}
+
+bool compute_flip_graph_sharded(int n, int threads, GraphBuilder& builder, std::vector<int>& code_order,
+                                ShardStatistics& statistics, int shards) {
+    if (triangulation_count(n) < 0) { return false; }
+    ShardedSearch search(n, std::max(1, threads), shards, builder, statistics);
+    return search.run(code_order);
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
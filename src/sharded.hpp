@@ -0,0 +1,63 @@
+/* ---------------------------------------------------------------------- *
+ * sharded.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_SHARDED__
+#define __FG_SHARDED__
+
+#include "graph.hpp"
+
+#include <vector>
+#include <iostream>
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the shard statistics
+ * ---------------------------------------------------------------------- */
+
+struct ShardStatistics {
+    // the number of numa nodes
+    int nodes;
+
+    // the number of shards
+    int shards;
+
+    // whether the threads were pinned to the nodes of their shards
+    bool pinned;
+
+    // the number of triangulations of every shard
+    std::vector<long long> vertices;
+
+    // the number of codes forwarded within and across shards
+    long long local;
+    long long remote;
+
+    // constructor that builds empty statistics
+    ShardStatistics();
+};
+
+// writes the specified shard statistics to the specified stream
+void write_shard_statistics(const ShardStatistics& statistics, std::ostream& output_stream);
+
+/* ---------------------------------------------------------------------- *
+ * function declarations
+ * ---------------------------------------------------------------------- */
+
+// computes the flip graph on all triangulations with n vertices and the
+// indices of its vertices ordered by code using the specified number of
+// threads, with the index and the frontier sharded across numa nodes.
+// a positive number of shards overrides the shards of the topology, up to
+// one per thread. returns false if the number of triangulations is not
+// known or a shard is full
+bool compute_flip_graph_sharded(int n, int threads, CsrGraph& graph, std::vector<int>& code_order,
+                                ShardStatistics& statistics, int shards = 0);
+
+// computes the flip graph like the function above and passes its vertices
+// to the specified builder in the order of their indices
+bool compute_flip_graph_sharded(int n, int threads, GraphBuilder& builder, std::vector<int>& code_order,
+                                ShardStatistics& statistics, int shards = 0);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,71 @@
+/* ---------------------------------------------------------------------- *
+ * statistics.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "statistics.hpp"
+
+#include <algorithm>
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the flip graph statistics
+ * ---------------------------------------------------------------------- */
+
+FlipGraphStatistics::FlipGraphStatistics()
+    : n(0), vertices(0), degree_sum(0), loops(0), max_degree(0), fingerprints(-1), scheduler(0) {}
+
+long long FlipGraphStatistics::edges() const {
+    return degree_sum / 2;
+}
+
+void FlipGraphStatistics::add_vertex(int degree, int loops) {
+    // a loop appears once in an adjacency list
+    vertices++;
+    degree_sum += degree + loops;
+    this->loops += loops;
+    max_degree = std::max(max_degree, degree);
+    if ((int) degrees.size() <= degree) { degrees.resize(degree + 1, 0); }
+    degrees[degree]++;
+}
+
+void FlipGraphStatistics::add_vertices(const FlipGraphStatistics& statistics) {
+    vertices += statistics.vertices;
+    degree_sum += statistics.degree_sum;
+    loops += statistics.loops;
+    max_degree = std::max(max_degree, statistics.max_degree);
+    int size = (int) statistics.degrees.size();
+    if ((int) degrees.size() < size) { degrees.resize(size, 0); }
+    for (int i = 0; i < size; ++i) { degrees[i] += statistics.degrees[i]; }
+}
+
+/* ---------------------------------------------------------------------- *
+ * write functions
+ * ---------------------------------------------------------------------- */
+
+void write_statistics(const FlipGraphStatistics& statistics, std::ostream& output_stream) {
+    output_stream << "n: " << statistics.n << "\n";
+    output_stream << "vertices: " << statistics.vertices << "\n";
+    output_stream << "edges: " << statistics.edges() << "\n";
+    output_stream << "loops: " << statistics.loops << "\n";
+    output_stream << "max degree: " << statistics.max_degree << "\n";
+    if (statistics.fingerprints >= 0) { output_stream << "fingerprints: " << statistics.fingerprints << "\n"; }
+
+    output_stream << "degrees:";
+    int size = (int) statistics.degrees.size();
+    for (int i = 0; i < size; ++i) {
+        if (statistics.degrees[i] > 0) { output_stream << " " << i << "x" << statistics.degrees[i]; }
+    }
+    output_stream << "\n";
+
+    output_stream << "layers:";
+    size = (int) statistics.layers.size();
+    for (int i = 0; i < size; ++i) { output_stream << " " << statistics.layers[i]; }
+    output_stream << "\n";
+
+    if (!statistics.scheduler.tasks.empty()) {
+        write_scheduler_statistics(statistics.scheduler, output_stream);
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,71 @@
+/* ---------------------------------------------------------------------- *
+ * statistics.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_STATISTICS__
+#define __FG_STATISTICS__
+
+#include "scheduler.hpp"
+
+#include <vector>
+#include <iostream>
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the flip graph statistics
+ * ---------------------------------------------------------------------- */
+
+// the largest number of vertices for which the distinct fingerprints are
+// counted. counting keeps every distinct fingerprint, which are almost as
+// many as there are triangulations
+const int max_fingerprinted_order = 12;
+
+struct FlipGraphStatistics {
+    // the number of vertices of the triangulations
+    int n;
+
+    // the number of vertices of the flip graph
+    long long vertices;
+
+    // the sum of all degrees where loops count twice
+    long long degree_sum;
+
+    // the number of loops
+    long long loops;
+
+    // the maximum degree
+    int max_degree;
+
+    // the number of vertices of every degree
+    std::vector<long long> degrees;
+
+    // the number of distinct fingerprints of the triangulations or -1 if
+    // they are not counted
+    long long fingerprints;
+
+    // the number of vertices at every distance from the canonical triangulation
+    std::vector<long long> layers;
+
+    // the statistics of the scheduler if the graph was explored in parallel
+    SchedulerStatistics scheduler;
+
+    // constructor that builds empty statistics
+    FlipGraphStatistics();
+
+    // returns the number of edges including loops
+    long long edges() const;
+
+    // adds a vertex with the specified degree and number of loops
+    void add_vertex(int degree, int loops);
+
+    // adds the vertices counted by the specified statistics
+    void add_vertices(const FlipGraphStatistics& statistics);
+};
+
+// writes the specified statistics to the specified stream
+void write_statistics(const FlipGraphStatistics& statistics, std::ostream& output_stream);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -8,6 +8,7 @@
 
 #include <queue>
 #include <map>
+#include <algorithm>
 
 /* ---------------------------------------------------------------------- *
  * implementation of the vertex class
@@ -21,6 +22,10 @@ void Vertex::set_edge(Edge* edge) {
     edge_ = edge;
 }
 
+void Vertex::set_index(int index) {
+    index_ = index;
+}
+
 int Vertex::label() const {
     return label_;
 }
@@ -29,6 +34,21 @@ Edge* Vertex::edge() const {
     return edge_;
 }
 
+int Vertex::degree() const {
+    Edge* first = edge_;
+    Edge* current = first;
+    int degree = 0;
+    do {
+        degree++;
+        current = current->twin()->next();
+    } while (current != first);
+    return degree;
+}
+
+int Vertex::index() const {
+    return index_;
+}
+
 /* ---------------------------------------------------------------------- *
  * implementation of the edge class
  * ---------------------------------------------------------------------- */
@@ -49,6 +69,10 @@ void Edge::set_next(Edge* edge) {
     next_ = edge;
 }
 
+void Edge::set_index(int index) {
+    index_ = index;
+}
+
 Vertex* Edge::target() const {
     return target_;
 }
@@ -65,15 +89,19 @@ Edge* Edge::next() const {
     return next_;
 }
 
+int Edge::index() const {
+    return index_;
+}
+
 /* ---------------------------------------------------------------------- *
  * implementation of the triangulation class
  * ---------------------------------------------------------------------- */
 
-Triangulation::Triangulation(int n) {
+Triangulation::Triangulation(int n) : fingerprint_(0), fingerprinted_(false) {
     make_canonical(n);
 }
 
-Triangulation::Triangulation(const Code& code) {
+Triangulation::Triangulation(const Code& code) : fingerprint_(0), fingerprinted_(false) {
     build_from_code(code);
 }
 
@@ -87,12 +115,14 @@ Triangulation::~Triangulation() {
 
 Vertex* Triangulation::new_vertex() {
     Vertex* vertex = new Vertex();
+    vertex->set_index((int) vertices_.size());
     vertices_.push_back(vertex);
     return vertex;
 }
 
 Edge* Triangulation::new_edge() {
     Edge* edge = new Edge();
+    edge->set_index((int) edges_.size());
     edges_.push_back(edge);
     return edge;
 }
@@ -235,6 +265,10 @@ void Triangulation::copy(const Triangulation& triangulation) {
         copy->set_prev(edge_map[edge->prev()]);
         copy->set_next(edge_map[edge->next()]);
     }
+
+    fingerprint_ = triangulation.fingerprint_;
+    fingerprinted_ = triangulation.fingerprinted_;
+    degrees_ = triangulation.degrees_;
 }
 
 void Triangulation::clear() {
@@ -246,6 +280,109 @@ void Triangulation::clear() {
     vertices_.clear();
 }
 
+/* ---------------------------------------------------------------------- *
+ * fingerprint
+ *
+ * the fingerprint is the sum of a hash of the degree of every vertex, a
+ * hash of the degrees of the endpoints of every edge and a hash of the
+ * degrees of the corners of every face. a flip changes the degrees of its
+ * four vertices only, so it suffices to subtract and add the terms of these
+ * vertices and their incident edges and faces. this is only done if the
+ * fingerprint is maintained, in which case the degrees are stored as well.
+ * otherwise flips do no bookkeeping and the fingerprint is computed when
+ * it is asked for.
+ * ---------------------------------------------------------------------- */
+
+namespace {
+
+// mixes the bits of the specified value, finalizer of splitmix64
+uint64_t mix(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ull;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebull;
+    value ^= value >> 31;
+    return value;
+}
+
+// returns the term of a vertex with the specified degree
+uint64_t vertex_term(int degree) {
+    return mix(0x9e3779b97f4a7c15ull + (uint64_t) degree);
+}
+
+// returns the term of an edge between vertices with the specified degrees
+uint64_t edge_term(int degree_a, int degree_b) {
+    uint64_t low = (uint64_t) std::min(degree_a, degree_b);
+    uint64_t high = (uint64_t) std::max(degree_a, degree_b);
+    return mix((high << 32) | low);
+}
+
+// returns the term of a face whose corners have the specified degrees
+uint64_t face_term(int degree_a, int degree_b, int degree_c) {
+    uint64_t low = (uint64_t) std::min(degree_a, std::min(degree_b, degree_c));
+    uint64_t high = (uint64_t) std::max(degree_a, std::max(degree_b, degree_c));
+    uint64_t middle = (uint64_t) (degree_a + degree_b + degree_c) - low - high;
+    return mix(mix((high << 40) | (middle << 20) | low) + 0x632be59bd9b4e019ull);
+}
+
+}
+
+void Triangulation::compute_degrees(std::vector<int>& degrees) const {
+    // every vertex is the target of one edge per neighbor
+    int m = size();
+    degrees.assign(order(), 0);
+    for (int i = 0; i < m; ++i) { degrees[edges_[i]->target()->index()]++; }
+}
+
+uint64_t Triangulation::compute_fingerprint(const std::vector<int>& degrees) const {
+    uint64_t fingerprint = 0;
+    int n = order();
+    int m = size();
+    for (int i = 0; i < n; ++i) { fingerprint += vertex_term(degrees[i]); }
+    for (int i = 0; i < m; ++i) {
+        Edge* edge = edges_[i];
+        int degree = degrees[edge->target()->index()];
+        if (edge < edge->twin()) {
+            fingerprint += edge_term(degree, degrees[edge->twin()->target()->index()]);
+        }
+        if (edge < edge->next() && edge < edge->prev()) {
+            fingerprint += face_term(degree, degrees[edge->next()->target()->index()],
+                                     degrees[edge->prev()->target()->index()]);
+        }
+    }
+    return fingerprint;
+}
+
+uint64_t Triangulation::local_fingerprint(Vertex* const* vertices, int count) const {
+    uint64_t result = 0;
+    for (int i = 0; i < count; ++i) {
+        Vertex* vertex = vertices[i];
+        int degree = degrees_[vertex->index()];
+        result += vertex_term(degree);
+
+        Edge* first = vertex->edge();
+        Edge* current = first;
+        do {
+            // edges and faces shared by several of the vertices are
+            // counted for the first of them only
+            Vertex* other = current->target();
+            Vertex* third = current->next()->target();
+            int j = 0;
+            int k = 0;
+            while (j < count && vertices[j] != other) { j++; }
+            while (k < count && vertices[k] != third) { k++; }
+            if (j > i) {
+                result += edge_term(degree, degrees_[other->index()]);
+            }
+            if (j > i && k > i) {
+                result += face_term(degree, degrees_[other->index()], degrees_[third->index()]);
+            }
+            current = current->twin()->next();
+        } while (current != first);
+    }
+    return result;
+}
+
 int Triangulation::order() const {
     return (int) vertices_.size();
 }
@@ -272,6 +409,22 @@ Edge* Triangulation::edge(Vertex* vertex_a, Vertex* vertex_b) const {
     return nullptr;
 }
 
+uint64_t Triangulation::fingerprint() const {
+    if (fingerprinted_) { return fingerprint_; }
+    std::vector<int> degrees;
+    compute_degrees(degrees);
+    return compute_fingerprint(degrees);
+}
+
+void Triangulation::set_fingerprinted(bool fingerprinted) {
+    if (fingerprinted && !fingerprinted_) {
+        compute_degrees(degrees_);
+        fingerprint_ = compute_fingerprint(degrees_);
+    }
+    if (!fingerprinted) { std::vector<int>().swap(degrees_); }
+    fingerprinted_ = fingerprinted;
+}
+
 bool Triangulation::is_representative(Edge* edge) {
     return edge < edge->twin();
 }
@@ -300,6 +453,8 @@ void Triangulation::flip(Edge* edge) {
     Edge* edge_as = edge->prev();
     Edge* edge_sb = twin->next();
     Edge* edge_bt = twin->prev();
+    Vertex* affected[] = { vertex_t, vertex_s, vertex_a, vertex_b };
+    if (fingerprinted_) { fingerprint_ -= local_fingerprint(affected, 4); }
     
     make_triangle(edge, edge_bt, edge_ta);
     make_triangle(twin, edge_as, edge_sb);
@@ -307,6 +462,14 @@ void Triangulation::flip(Edge* edge) {
     twin->set_target(vertex_a);
     if (vertex_t->edge() == twin) { vertex_t->set_edge(edge_ta); }
     if (vertex_s->edge() == edge) { vertex_s->set_edge(edge_sb); }
+
+    if (fingerprinted_) {
+        degrees_[vertex_t->index()]--;
+        degrees_[vertex_s->index()]--;
+        degrees_[vertex_a->index()]++;
+        degrees_[vertex_b->index()]++;
+        fingerprint_ += local_fingerprint(affected, 4);
+    }
 }
 
 /* ---------------------------------------------------------------------- *
@@ -321,6 +484,12 @@ Code::Code(const Triangulation& triangulation, Edge* edge) {
     compute_code(triangulation, edge);
 }
 
+Code::Code(const unsigned char* symbols, int length) {
+    length_ = length;
+    code_ = new unsigned char[length_];
+    for (int i = 0; i < length_; ++i) { code_[i] = symbols[i]; }
+}
+
 Code::Code(const Code& code) {
     length_ = code.length_;
     code_ = new unsigned char[length_];
@@ -413,6 +582,10 @@ unsigned char Code::symbol(int i) const {
     return code_[i];
 }
 
+const unsigned char* Code::symbols() const {
+    return code_;
+}
+
 int Code::length() const {
     return length_;
 }
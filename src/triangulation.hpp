@@ -9,6 +9,7 @@
 
 #include <vector>
 #include <iostream>
+#include <cstdint>
 
 /* ---------------------------------------------------------------------- *
  * forward declarations
@@ -30,10 +31,16 @@ class Code;
     // an incident edge
     Edge* edge_;
 
+    // the position in the vertices of the triangulation
+    int index_;
+
 public:
     // sets this vertex's label to the specified label
     void set_label(int label);
 
+    // sets this vertex's index to the specified index
+    void set_index(int index);
+
     // makes the specified edge incident to this vertex
     void set_edge(Edge* edge_);
 
@@ -42,6 +49,12 @@ public:
 
     // returns an edge incident to this vertex
     Edge* edge() const;
+
+    // returns this vertex's degree, counted along its incident edges
+    int degree() const;
+
+    // returns this vertex's index
+    int index() const;
  };
 
 /* ---------------------------------------------------------------------- *
@@ -61,6 +74,9 @@ class Edge {
     // the next edge of the incident face
     Edge* next_;
 
+    // the position in the edges of the triangulation
+    int index_;
+
 public:
     // sets the target vertex to the specified vertex
     void set_target(Vertex* vertex);
@@ -74,6 +90,9 @@ public:
     // sets the next edge to the specified edge
     void set_next(Edge* edge);
 
+    // sets this edge's index to the specified index
+    void set_index(int index);
+
     // returns the target vertex
     Vertex* target() const;
 
@@ -85,6 +104,9 @@ public:
 
     // returns the next edge of the incident face
     Edge* next() const;
+
+    // returns this edge's index
+    int index() const;
 };
 
 /* ---------------------------------------------------------------------- *
@@ -112,6 +134,15 @@ private:
     // the list of edges
     std::vector<Edge*> edges_;
 
+    // the isomorphism invariant fingerprint if it is maintained
+    uint64_t fingerprint_;
+
+    // whether flips maintain the fingerprint
+    bool fingerprinted_;
+
+    // the degree of every vertex if the fingerprint is maintained
+    std::vector<int> degrees_;
+
     // creates and returns a new vertex
     Vertex* new_vertex();
 
@@ -146,6 +177,16 @@ private:
     // removes all vertices and edges from the triangulation
     void clear();
 
+    // computes the degrees of all vertices
+    void compute_degrees(std::vector<int>& degrees) const;
+
+    // computes the fingerprint from the specified degrees of all vertices
+    uint64_t compute_fingerprint(const std::vector<int>& degrees) const;
+
+    // returns the part of the maintained fingerprint that depends on the
+    // degrees of the specified vertices
+    uint64_t local_fingerprint(Vertex* const* vertices, int count) const;
+
 public:
     // returns the number of vertices
     int order() const;
@@ -162,6 +203,17 @@ public:
     // returns the edge from the first specified vertex to the second
     Edge* edge(Vertex* vertex_a, Vertex* vertex_b) const;
 
+    // returns a hash of the triangulation that is invariant under
+    // isomorphism. it combines the degrees of all vertices, of the endpoints
+    // of all edges and of the corners of all faces. it is computed in o(n)
+    // unless it is maintained
+    uint64_t fingerprint() const;
+
+    // sets whether flips maintain the fingerprint, which is most of the cost
+    // of a flip and pays off only if it is asked for after every few flips.
+    // the fingerprint is not maintained by default
+    void set_fingerprinted(bool fingerprinted);
+
     // returns whether the specified edge or its twin is representative
     bool is_representative(Edge* edge);
 
@@ -185,6 +237,9 @@ public:
     // at the specified edge
     Code(const Triangulation& triangulation, Edge* edge);
 
+    // constructor that copies the specified symbols
+    Code(const unsigned char* symbols, int length);
+
     // constructor that copies the specified code
     Code(const Code& code);
 
@@ -220,6 +275,9 @@ public:
     // returns the i-th symbol of the code
     unsigned char symbol(int i) const;
 
+    // returns the array of symbols of the code
+    const unsigned char* symbols() const;
+
     // returns the lenghh of the code
     int length() const;
 
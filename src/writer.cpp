@@ -0,0 +1,218 @@
+/* ---------------------------------------------------------------------- *
+ * writer.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "writer.hpp"
+#include "compression.hpp"
+
+#include <chrono>
+#include <cstring>
+
+/* ---------------------------------------------------------------------- *
+ * helper functions
+ * ---------------------------------------------------------------------- */
+
+namespace {
+
+// appends the decimal representation of the specified non-negative integer
+void append_int(int value, std::vector<char>& bytes) {
+    char digits[16];
+    int length = 0;
+    do {
+        digits[length++] = (char) ('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (length > 0) { bytes.push_back(digits[--length]); }
+}
+
+// appends the specified integer as 32-bit little-endian integer
+void append_binary(int value, std::vector<char>& bytes) {
+    uint32_t bits = (uint32_t) value;
+    for (int i = 0; i < 4; ++i) { bytes.push_back((char) ((bits >> (8 * i)) & 0xff)); }
+}
+
+}
+
+bool parse_graph_format(const std::string& name, GraphFormat& format) {
+    if (name == "text") { format = FORMAT_TEXT; return true; }
+    if (name == "binary") { format = FORMAT_BINARY; return true; }
+    return false;
+}
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the writer statistics
+ * ---------------------------------------------------------------------- */
+
+WriterStatistics::WriterStatistics()
+    : vertices(0), raw_bytes(0), written_bytes(0), waits(0), blocked(0.0) {}
+
+void write_writer_statistics(const WriterStatistics& statistics, std::ostream& output_stream) {
+    output_stream << "written vertices: " << statistics.vertices << "\n";
+    output_stream << "written bytes: " << statistics.written_bytes;
+    if (statistics.written_bytes != statistics.raw_bytes) {
+        output_stream << " (" << statistics.raw_bytes << " before compression)";
+    }
+    output_stream << "\n";
+    output_stream << "writer waits: " << statistics.waits << " (" << statistics.blocked << " s)\n";
+}
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the graph writer class
+ * ---------------------------------------------------------------------- */
+
+GraphWriter::GraphWriter(std::ostream& output_stream, GraphFormat format, bool compress, bool header)
+    : output_stream_(output_stream), format_(format), compress_(compress), header_(header),
+      buffers_(buffer_count), allocated_(0), current_(0), finished_(false),
+      failed_(false) {
+    for (int i = 1; i < buffer_count; ++i) { free_.push_back(i); }
+    thread_ = std::thread(&GraphWriter::run, this);
+}
+
+GraphWriter::~GraphWriter() {
+    finish();
+}
+
+void GraphWriter::submit() {
+    typedef std::chrono::steady_clock Clock;
+    std::unique_lock<std::mutex> lock(mutex_);
+    full_.push_back(current_);
+    condition_.notify_all();
+
+    if (free_.empty()) {
+        // backpressure: the writer thread is behind
+        Clock::time_point start = Clock::now();
+        statistics_.waits++;
+        condition_.wait(lock, [this]() { return !free_.empty(); });
+        statistics_.blocked += std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    current_ = free_.front();
+    free_.pop_front();
+}
+
+void GraphWriter::emit(const std::vector<char>& bytes, std::vector<char>& compressed) {
+    statistics_.raw_bytes += (long long) bytes.size();
+    if (compress_) {
+        compressed.clear();
+        compress_frame(bytes.data(), (int) bytes.size(), compressed);
+        output_stream_.write(compressed.data(), compressed.size());
+        statistics_.written_bytes += (long long) compressed.size();
+    } else {
+        output_stream_.write(bytes.data(), bytes.size());
+        statistics_.written_bytes += (long long) bytes.size();
+    }
+}
+
+void GraphWriter::format(const std::vector<int>& buffer, std::vector<char>& bytes) {
+    bytes.clear();
+    int size = (int) buffer.size();
+    int position = 0;
+    while (position < size) {
+        int index = buffer[position];
+        int degree = buffer[position + 1];
+        const int* neighbors = buffer.data() + position + 2;
+        position += 2 + degree;
+
+        if (format_ == FORMAT_TEXT) {
+            append_int(index, bytes);
+            bytes.push_back(':');
+            for (int j = 0; j < degree; ++j) {
+                bytes.push_back(' ');
+                append_int(neighbors[j], bytes);
+            }
+            bytes.push_back('\n');
+        } else {
+            append_binary(index, bytes);
+            append_binary(degree, bytes);
+            for (int j = 0; j < degree; ++j) { append_binary(neighbors[j], bytes); }
+        }
+    }
+}
+
+void GraphWriter::run() {
+    std::vector<char> bytes;
+    std::vector<char> compressed;
+
+    if (compress_ && header_) {
+        output_stream_.write(compression_magic, 4);
+        statistics_.written_bytes += 4;
+    }
+    if (format_ == FORMAT_BINARY && header_) {
+        bytes.assign(binary_magic, binary_magic + 4);
+        emit(bytes, compressed);
+    }
+
+    while (true) {
+        int buffer;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this]() { return !full_.empty() || finished_; });
+            if (full_.empty()) { break; }
+            buffer = full_.front();
+            full_.pop_front();
+        }
+
+        if (!failed_) {
+            format(buffers_[buffer], bytes);
+            emit(bytes, compressed);
+            output_stream_.flush();
+            failed_ = !output_stream_.good();
+        }
+        buffers_[buffer].clear();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(buffer);
+        condition_.notify_all();
+    }
+
+    output_stream_.flush();
+    if (!output_stream_.good()) { failed_ = true; }
+}
+
+void GraphWriter::write_vertex(int index, const int* neighbors, int degree) {
+    std::vector<int>& buffer = buffers_[current_];
+    if (!buffer.empty() && (int) buffer.size() + 2 + degree > buffer_size) {
+        submit();
+    }
+
+    std::vector<int>& target = buffers_[current_];
+    size_t capacity = target.capacity();
+    target.push_back(index);
+    target.push_back(degree);
+    target.insert(target.end(), neighbors, neighbors + degree);
+    allocated_ += (long long) (target.capacity() - capacity) * sizeof(int);
+    statistics_.vertices++;
+}
+
+bool GraphWriter::finish() {
+    if (!thread_.joinable()) { return !failed_; }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!buffers_[current_].empty()) { full_.push_back(current_); }
+        finished_ = true;
+        condition_.notify_all();
+    }
+    thread_.join();
+    return !failed_;
+}
+
+const WriterStatistics& GraphWriter::statistics() const {
+    return statistics_;
+}
+
+long long GraphWriter::memory() const {
+    return allocated_;
+}
+
+/* ---------------------------------------------------------------------- *
+ * write functions
+ * ---------------------------------------------------------------------- */
+
+void write_flip_graph(const CsrGraph& graph, GraphWriter& writer) {
+    int n = graph.order();
+    for (int i = 0; i < n; ++i) { writer.write_vertex(i, graph.neighbors(i), graph.degree(i)); }
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,167 @@
+/* ---------------------------------------------------------------------- *
+ * writer.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FG_WRITER__
+#define __FG_WRITER__
+
+#include "graph.hpp"
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <iostream>
+
+// the formats a flip graph can be written in. the text format consists of
+// lines "i: a b c". the binary format consists of the magic "FGB1" followed
+// by the index, the degree and the neighbors of every vertex as 32-bit
+// little-endian integers
+enum GraphFormat {
+    FORMAT_TEXT,
+    FORMAT_BINARY
+};
+
+// the magic of the binary format
+const char binary_magic[] = "FGB1";
+
+// returns the format with the specified name or false if it does not exist
+bool parse_graph_format(const std::string& name, GraphFormat& format);
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the writer statistics
+ * ---------------------------------------------------------------------- */
+
+struct WriterStatistics {
+    // the number of vertices written
+    long long vertices;
+
+    // the number of bytes before compression
+    long long raw_bytes;
+
+    // the number of bytes written to the stream
+    long long written_bytes;
+
+    // the number of times the producer waited for a free buffer
+    long long waits;
+
+    // the time in seconds the producer waited for a free buffer
+    double blocked;
+
+    // constructor that builds empty statistics
+    WriterStatistics();
+};
+
+// writes the specified writer statistics to the specified stream
+void write_writer_statistics(const WriterStatistics& statistics, std::ostream& output_stream);
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the graph writer class
+ *
+ * writes adjacency lists to a stream on a thread of its own. the producer
+ * copies every adjacency list into the current buffer. full buffers are
+ * handed to the writer thread, which formats, optionally compresses and
+ * writes them and then returns them to the pool of free buffers. the
+ * producer only waits if no buffer is free. buffers are allocated as they
+ * are needed, so a small graph does not pay for all of them.
+ * ---------------------------------------------------------------------- */
+
+class GraphWriter {
+public:
+    // constructor that writes to the specified stream in the specified
+    // format. the magic is omitted if the stream continues an earlier output
+    GraphWriter(std::ostream& output_stream, GraphFormat format, bool compress, bool header = true);
+
+    // destructor that finishes the writer
+    ~GraphWriter();
+
+private:
+    // the number of buffers
+    static const int buffer_count = 4;
+
+    // the number of integers per buffer
+    static const int buffer_size = 1 << 18;
+
+    // the output stream
+    std::ostream& output_stream_;
+
+    // the output format
+    GraphFormat format_;
+
+    // whether the output is compressed
+    bool compress_;
+
+    // whether the magic is written
+    bool header_;
+
+    // the buffers holding index, degree and neighbors of every vertex. they
+    // grow as they are filled and keep their capacity once written
+    std::vector<std::vector<int> > buffers_;
+
+    // the number of bytes allocated by the buffers, which only the producer
+    // changes
+    long long allocated_;
+
+    // the buffer being filled by the producer
+    int current_;
+
+    // the buffers that are free and the buffers that are waiting to be written
+    std::deque<int> free_;
+    std::deque<int> full_;
+
+    // whether the producer is finished
+    bool finished_;
+
+    // whether writing to the stream failed, set by the writer thread
+    bool failed_;
+
+    // the mutex and condition guarding the queues
+    std::mutex mutex_;
+    std::condition_variable condition_;
+
+    // the writer thread
+    std::thread thread_;
+
+    // the statistics
+    WriterStatistics statistics_;
+
+    // hands the current buffer to the writer thread and takes a free one
+    void submit();
+
+    // writes the specified bytes to the stream, compressing them if requested
+    void emit(const std::vector<char>& bytes, std::vector<char>& compressed);
+
+    // formats the specified buffer
+    void format(const std::vector<int>& buffer, std::vector<char>& bytes);
+
+    // the loop of the writer thread
+    void run();
+
+    // copies the writer so copies are not possible
+    GraphWriter(const GraphWriter& writer);
+
+public:
+    // writes the adjacency list of the vertex with the specified index
+    void write_vertex(int index, const int* neighbors, int degree);
+
+    // writes all pending buffers and stops the writer thread. returns false
+    // if writing to the stream failed
+    bool finish();
+
+    // returns the statistics
+    const WriterStatistics& statistics() const;
+
+    // returns the number of bytes allocated by the buffers so far
+    long long memory() const;
+};
+
+// writes the specified flip graph to the specified writer
+void write_flip_graph(const CsrGraph& graph, GraphWriter& writer);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
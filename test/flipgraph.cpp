@@ -0,0 +1,624 @@
+/* ---------------------------------------------------------------------- *
+ * flipgraph.cpp
+ *
+ * tests of the flip graph against the known numbers of triangulations and
+ * reference values of the flip graphs, also restricted by predicates. the
+ * engines are compared with each other after their vertices are relabeled in the order of their codes.
+ * every test runs under a time budget and fails if it takes longer, so a
+ * performance regression fails the suite as well.
+ *
+ * usage: test_flipgraph [-b budget factor] [-t threads]
+ * ---------------------------------------------------------------------- */
+
+#include "../src/options.hpp"
+#include "../src/triangulation.hpp"
+#include "../src/flipgraph.hpp"
+#include "../src/predicate.hpp"
+#include "../src/memory.hpp"
+#include "../src/parallel.hpp"
+#include "../src/sharded.hpp"
+#include "../src/labeled.hpp"
+#include "../src/reader.hpp"
+#include "../src/writer.hpp"
+#include "../src/numa.hpp"
+#include "../src/ordering.hpp"
+#include "../src/statistics.hpp"
+#include "../src/functions.hpp"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+/* ---------------------------------------------------------------------- *
+ * reference values
+ * ---------------------------------------------------------------------- */
+
+// the smallest and largest number of vertices that are tested
+const int min_n = 4;
+const int max_n = 12;
+
+// the number of triangulations with n vertices, see oeis a000109
+const long long reference_vertices[] = {1, 1, 2, 5, 14, 50, 233, 1249, 7595};
+
+// the number of adjacency entries of the flip graph with n vertices, where
+// every edge is counted twice and every loop once
+const long long reference_entries[] = {0, 1, 3, 13, 65, 401, 2694, 19052, 139696};
+
+// the number of loops and the diameter of the flip graph with 12 vertices
+const long long reference_loops_12 = 552;
+const int reference_diameter_12 = 11;
+
+// the smallest number of vertices for which the restricted classes are
+// tested and the orders of the components that are explored. the restricted
+// flip graphs are not connected and the search stays in the component of
+// its start, which misses the triangulations without accepted flips: one
+// of the classes of oeis a000103 for minimum degree 4 and a007021 without
+// separating triangles, and up to two of maximum degree 6
+const int min_restricted_n = 9;
+const long long reference_min_degree_4[] = {4, 11, 33, 129};
+const long long reference_no_separating[] = {3, 9, 24, 86};
+const long long reference_max_degree_6[] = {15, 29, 43, 75};
+
+// the largest number of vertices for which the labeled flip graphs are
+// tested, the number of labeled triangulations, see oeis a096332, and the
+// number of labeled triangulations with a fixed outer triangle
+const int max_labeled_n = 7;
+const long long reference_labeled[] = {1, 10, 195, 5712};
+const long long reference_fixed_outer[] = {1, 6, 78, 1632};
+
+/* ---------------------------------------------------------------------- *
+ * helper functions
+ * ---------------------------------------------------------------------- */
+
+// returns the number of loops of the specified graph
+long long count_loops(const CsrGraph& graph) {
+    long long loops = 0;
+    for (int i = 0; i < graph.order(); ++i) {
+        for (int j = 0; j < graph.degree(i); ++j) {
+            if (graph.neighbor(i, j) == i) { loops++; }
+        }
+    }
+    return loops;
+}
+
+// returns whether the specified graphs are equal
+bool equal_graphs(const CsrGraph& a, const CsrGraph& b) {
+    if (a.order() != b.order() || a.size() != b.size()) { return false; }
+    for (int i = 0; i < a.order(); ++i) {
+        if (a.degree(i) != b.degree(i)) { return false; }
+        for (int j = 0; j < a.degree(i); ++j) {
+            if (a.neighbor(i, j) != b.neighbor(i, j)) { return false; }
+        }
+    }
+    return true;
+}
+
+// checks the order and the size of the specified graph against the
+// reference values
+bool check_counts(const std::string& engine, int n, const CsrGraph& graph) {
+    long long vertices = reference_vertices[n - min_n];
+    long long entries = reference_entries[n - min_n];
+    if (graph.order() != vertices || graph.size() != entries) {
+        std::cout << "  " << engine << ", n = " << n << ": " << graph.order() << " vertices and "
+                  << graph.size() << " entries, expected " << vertices << " and " << entries << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// returns the code of the specified triangulation with its vertices and
+// the rotation of every vertex relabeled at random and with its orientation
+// reversed with probability one half. the code is read like a canonical
+// code, hence the triangulation it describes is isomorphic to the specified
+// triangulation
+Code random_code(const Triangulation& triangulation, std::mt19937& random) {
+    int n = triangulation.order();
+    int m = triangulation.size();
+
+    // the vertex labels hold the indices of the vertices
+    for (int i = 0; i < n; ++i) { triangulation.vertex(i)->set_label(i); }
+
+    std::vector<int> permutation(n);
+    for (int i = 0; i < n; ++i) { permutation[i] = i; }
+    std::shuffle(permutation.begin(), permutation.end(), random);
+    std::vector<int> inverse(n);
+    for (int i = 0; i < n; ++i) { inverse[permutation[i]] = i; }
+    bool mirrored = random() % 2 == 1;
+
+    std::vector<unsigned char> symbols;
+    symbols.push_back((unsigned char) n);
+    for (int label = 0; label < n; ++label) {
+        Vertex* vertex = triangulation.vertex(inverse[label]);
+
+        // the rotation starts at a random edge
+        std::vector<int> rotation;
+        Edge* first = vertex->edge();
+        Edge* current = first;
+        do {
+            rotation.push_back(permutation[current->target()->label()]);
+            current = current->twin()->next();
+        } while (current != first);
+        int offset = (int) (random() % rotation.size());
+        std::rotate(rotation.begin(), rotation.begin() + offset, rotation.end());
+        if (mirrored) { std::reverse(rotation.begin(), rotation.end()); }
+
+        for (size_t j = 0; j < rotation.size(); ++j) { symbols.push_back((unsigned char) (rotation[j] + 1)); }
+        symbols.push_back(0);
+    }
+
+    return Code(symbols.data(), n + m + 1);
+}
+
+/* ---------------------------------------------------------------------- *
+ * tests
+ * ---------------------------------------------------------------------- */
+
+// the number of threads of the parallel engine
+int threads = 4;
+
+// checks the counts of the generic engine and keeps its graphs in code order
+std::vector<CsrGraph> generic_graphs;
+
+bool test_generic_counts() {
+    bool success = true;
+    generic_graphs.clear();
+    for (int n = min_n; n <= max_n; ++n) {
+        CsrGraph graph;
+        std::vector<int> code_order;
+        compute_flip_graph(n, graph, code_order);
+        success &= check_counts("generic", n, graph);
+
+        generic_graphs.push_back(CsrGraph());
+        relabel_graph(graph, code_order, generic_graphs.back());
+    }
+    return success;
+}
+
+bool test_fixed_engine() {
+    bool success = true;
+    for (int n = min_n; n <= max_n; ++n) {
+        CsrGraph graph;
+        std::vector<int> code_order;
+        if (!compute_fixed_flip_graph(n, graph, code_order)) {
+            std::cout << "  fixed, n = " << n << ": not supported" << std::endl;
+            success = false;
+            continue;
+        }
+        success &= check_counts("fixed", n, graph);
+
+        CsrGraph relabeled;
+        relabel_graph(graph, code_order, relabeled);
+        if (!equal_graphs(relabeled, generic_graphs[n - min_n])) {
+            std::cout << "  fixed, n = " << n << ": differs from the generic engine" << std::endl;
+            success = false;
+        }
+    }
+    return success;
+}
+
+bool test_parallel_engine() {
+    bool success = true;
+    Scheduler scheduler(threads);
+    for (int n = min_n; n <= max_n; ++n) {
+        CsrGraph graph;
+        std::vector<int> code_order;
+        if (!compute_flip_graph_parallel(n, scheduler, graph, code_order)) {
+            std::cout << "  parallel, n = " << n << ": failed" << std::endl;
+            success = false;
+            continue;
+        }
+        success &= check_counts("parallel", n, graph);
+
+        CsrGraph relabeled;
+        relabel_graph(graph, code_order, relabeled);
+        if (!equal_graphs(relabeled, generic_graphs[n - min_n])) {
+            std::cout << "  parallel, n = " << n << ": differs from the generic engine" << std::endl;
+            success = false;
+        }
+    }
+    return success;
+}
+
+// returns the specified recorded codes concatenated in code order
+std::vector<unsigned char> codes_in_order(const std::vector<unsigned char>& codes, const std::vector<int>& code_order,
+                                          int length) {
+    std::vector<unsigned char> result;
+    for (size_t i = 0; i < code_order.size(); ++i) {
+        const unsigned char* symbols = codes.data() + (size_t) code_order[i] * length;
+        result.insert(result.end(), symbols, symbols + length);
+    }
+    return result;
+}
+
+bool test_recorded_codes() {
+    const int n = 10;
+    const int length = 7 * n - 11;
+    const char* names[] = {"generic", "fixed", "parallel", "sharded"};
+    Scheduler scheduler(threads);
+    ShardStatistics statistics;
+
+    std::vector<unsigned char> expected;
+    for (int engine = 0; engine < 4; ++engine) {
+        CsrGraph graph;
+        GraphBuilder builder(graph);
+        std::vector<unsigned char> codes;
+        builder.record_codes(codes);
+        std::vector<int> code_order;
+        if (engine == 0) { compute_flip_graph(n, builder, code_order); }
+        if (engine == 1) { compute_fixed_flip_graph(n, builder, code_order); }
+        if (engine == 2) { compute_flip_graph_parallel(n, scheduler, builder, code_order); }
+        if (engine == 3) { compute_flip_graph_sharded(n, threads, builder, code_order, statistics); }
+
+        // the codes are distinct and in code order, hence the same for all
+        // engines
+        std::vector<unsigned char> ordered = codes_in_order(codes, code_order, length);
+        if ((long long) ordered.size() != reference_vertices[n - min_n] * length) {
+            std::cout << "  " << names[engine] << ": " << codes.size() / length << " codes recorded" << std::endl;
+            return false;
+        }
+        if (engine == 0) {
+            expected = ordered;
+            for (size_t i = length; i < ordered.size(); i += length) {
+                if (std::memcmp(&ordered[i - length], &ordered[i], length) >= 0) {
+                    std::cout << "  generic: codes are not in code order" << std::endl;
+                    return false;
+                }
+            }
+        } else if (ordered != expected) {
+            std::cout << "  " << names[engine] << ": codes differ from the generic engine" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool test_sharded_engine() {
+    bool success = true;
+    for (int n = min_n; n <= max_n; ++n) {
+        CsrGraph graph;
+        std::vector<int> code_order;
+        ShardStatistics statistics;
+        if (!compute_flip_graph_sharded(n, threads, graph, code_order, statistics)) {
+            std::cout << "  sharded, n = " << n << ": failed" << std::endl;
+            success = false;
+            continue;
+        }
+        success &= check_counts("sharded", n, graph);
+
+        CsrGraph relabeled;
+        relabel_graph(graph, code_order, relabeled);
+        if (!equal_graphs(relabeled, generic_graphs[n - min_n])) {
+            std::cout << "  sharded, n = " << n << ": differs from the generic engine" << std::endl;
+            success = false;
+        }
+    }
+
+    // forced shards, which are shared by several threads, independent of
+    // the topology and the number of threads of the test
+    const int forced_threads = 5;
+    for (int shards = 2; shards <= 3; ++shards) {
+        for (int n = min_n; n <= 10; ++n) {
+            CsrGraph graph;
+            std::vector<int> code_order;
+            ShardStatistics statistics;
+            if (!compute_flip_graph_sharded(n, forced_threads, graph, code_order, statistics, shards)
+                || statistics.shards != shards) {
+                std::cout << "  " << shards << " shards, n = " << n << ": failed" << std::endl;
+                success = false;
+                continue;
+            }
+
+            CsrGraph relabeled;
+            relabel_graph(graph, code_order, relabeled);
+            if (!equal_graphs(relabeled, generic_graphs[n - min_n])) {
+                std::cout << "  " << shards << " shards, n = " << n << ": differs from the generic engine"
+                          << std::endl;
+                success = false;
+            }
+        }
+    }
+
+    // the cpu lists of the numa nodes
+    std::vector<int> cpus;
+    if (!parse_cpu_list("0-3,8,10-11", cpus) || cpus != std::vector<int>({0, 1, 2, 3, 8, 10, 11})
+        || parse_cpu_list("3-1", cpus) || parse_cpu_list("a", cpus)) {
+        std::cout << "  cpu lists are not parsed correctly" << std::endl;
+        success = false;
+    }
+    return success;
+}
+
+bool test_statistics() {
+    bool success = true;
+    Scheduler scheduler(threads);
+    for (int n = min_n; n <= max_n; ++n) {
+        const CsrGraph& graph = generic_graphs[n - min_n];
+        long long loops = count_loops(graph);
+
+        FlipGraphStatistics sequential;
+        compute_flip_graph_statistics(n, sequential);
+        FlipGraphStatistics parallel;
+        compute_flip_graph_statistics_parallel(n, scheduler, parallel);
+
+        const FlipGraphStatistics* statistics[] = {&sequential, &parallel};
+        for (int i = 0; i < 2; ++i) {
+            const FlipGraphStatistics& s = *statistics[i];
+            if (s.vertices != graph.order() || s.degree_sum != graph.size() + loops || s.loops != loops) {
+                std::cout << "  " << (i == 0 ? "sequential" : "parallel") << " statistics, n = " << n
+                          << ": " << s.vertices << " vertices, degree sum " << s.degree_sum << ", "
+                          << s.loops << " loops" << std::endl;
+                success = false;
+            }
+        }
+    }
+    return success;
+}
+
+bool test_reference_12() {
+    const CsrGraph& graph = generic_graphs[12 - min_n];
+    long long loops = count_loops(graph);
+    int diameter = graph_diameter(graph);
+    if (loops != reference_loops_12 || diameter != reference_diameter_12) {
+        std::cout << "  n = 12: " << loops << " loops and diameter " << diameter << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool test_restricted_classes() {
+    bool success = true;
+    Scheduler scheduler(threads);
+    for (int n = min_restricted_n; n <= max_n; ++n) {
+        for (int i = 0; i < 3; ++i) {
+            PredicateList predicate;
+            const long long* references[] = {reference_min_degree_4, reference_no_separating,
+                                             reference_max_degree_6};
+            const char* names[] = {"minimum degree 4", "no separating triangles", "maximum degree 6"};
+            if (i == 0) { predicate.add(new MinDegreePredicate(4)); }
+            if (i == 1) { predicate.add(new SeparatingTrianglePredicate()); }
+            if (i == 2) { predicate.add(new MaxDegreePredicate(6)); }
+            long long vertices = references[i][n - min_restricted_n];
+            std::string name = names[i];
+
+            CsrGraph generic;
+            std::vector<int> generic_order;
+            GraphBuilder builder(generic);
+            MemoryBudget budget;
+            compute_flip_graph(n, builder, generic_order, budget, &predicate);
+
+            CsrGraph parallel;
+            std::vector<int> parallel_order;
+            compute_flip_graph_parallel(n, scheduler, parallel, parallel_order, &predicate);
+
+            CsrGraph a;
+            CsrGraph b;
+            relabel_graph(generic, generic_order, a);
+            relabel_graph(parallel, parallel_order, b);
+            if (generic.order() != vertices || !equal_graphs(a, b)) {
+                std::cout << "  " << name << ", n = " << n << ": " << generic.order() << " and "
+                          << parallel.order() << " vertices, expected " << vertices << std::endl;
+                success = false;
+            }
+        }
+    }
+    return success;
+}
+
+bool test_labeled_flip_graph() {
+    bool success = true;
+    for (int n = min_n; n <= max_labeled_n; ++n) {
+        for (int i = 0; i < 2; ++i) {
+            bool fixed_outer = (i == 1);
+            long long vertices = (fixed_outer ? reference_fixed_outer : reference_labeled)[n - min_n];
+            std::string name = fixed_outer ? "fixed outer triangle" : "labeled";
+
+            // flips change the labeled adjacency, hence there are no loops
+            CsrGraph graph;
+            std::vector<int> code_order;
+            compute_labeled_flip_graph(n, fixed_outer, graph, code_order);
+            if (graph.order() != vertices || count_loops(graph) != 0) {
+                std::cout << "  " << name << ", n = " << n << ": " << graph.order() << " vertices and "
+                          << count_loops(graph) << " loops, expected " << vertices << " and 0" << std::endl;
+                success = false;
+            }
+        }
+    }
+    return success;
+}
+
+bool test_labeled_codes() {
+    std::mt19937 random(42);
+    const int steps = 200;
+
+    for (int n = min_n; n <= 16; ++n) {
+        // random walk on the labeled flip graph
+        Triangulation triangulation(n);
+        for (int i = 0; i < n; ++i) { triangulation.vertex(i)->set_label(i); }
+        std::vector<unsigned char> code(7 * n - 11);
+        std::vector<unsigned char> mirrored_code(7 * n - 11);
+        for (int step = 0; step < steps; ++step) {
+            compute_labeled_code(triangulation, code.data());
+
+            // reversing every rotation mirrors the triangulation but keeps
+            // its labeled adjacency
+            std::vector<unsigned char> mirrored(code);
+            std::vector<unsigned char>::iterator begin = mirrored.begin() + 1;
+            while (begin != mirrored.end()) {
+                std::vector<unsigned char>::iterator end = std::find(begin, mirrored.end(), 0);
+                std::reverse(begin, end);
+                begin = end + 1;
+            }
+            Triangulation mirror(Code(mirrored.data(), (int) mirrored.size()));
+            for (int i = 0; i < n; ++i) { mirror.vertex(i)->set_label(i); }
+            compute_labeled_code(mirror, mirrored_code.data());
+            if (mirrored_code != code) {
+                std::cout << "  n = " << n << ", step " << step << ": mirrored copy differs" << std::endl;
+                return false;
+            }
+
+            Edge* edge = triangulation.edge((int) (random() % triangulation.size()));
+            if (triangulation.is_flippable(edge)) { triangulation.flip(edge); }
+        }
+    }
+    return true;
+}
+
+bool test_reader() {
+    const std::string path = "test_flipgraph.tmp";
+    bool success = true;
+
+    // written graphs are read back in all formats
+    const CsrGraph& graph = generic_graphs[9 - min_n];
+    for (int i = 0; i < 4; ++i) {
+        {
+            std::ofstream output_stream(path.c_str(), std::ios::out | std::ios::binary);
+            GraphWriter writer(output_stream, i % 2 == 0 ? FORMAT_TEXT : FORMAT_BINARY, i >= 2);
+            write_flip_graph(graph, writer);
+            if (!writer.finish()) {
+                std::cout << "  format " << i << ": writing failed" << std::endl;
+                success = false;
+            }
+        }
+        CsrGraph read;
+        if (!read_flip_graph(path, read, threads) || !equal_graphs(read, graph)) {
+            std::cout << "  format " << i << ": graph differs after reading" << std::endl;
+            success = false;
+        }
+    }
+
+    // a stream that cannot be written to makes the writer fail
+    {
+        std::ofstream output_stream;
+        GraphWriter writer(output_stream, FORMAT_TEXT, false);
+        write_flip_graph(graph, writer);
+        if (writer.finish()) {
+            std::cout << "  writing to a closed stream succeeded" << std::endl;
+            success = false;
+        }
+    }
+
+    // a compressed block whose literal length overflows an int
+    const int extensions = (1 << 23) + (1 << 17);
+    std::string overflow("FGZ1\x10\x00\x00\x00", 8);
+    for (int i = 0; i < 4; ++i) { overflow.push_back((char) (((extensions + 2) >> (8 * i)) & 0xff)); }
+    overflow.push_back((char) 0xf0);
+    overflow.append(extensions, (char) 0xff);
+    overflow.push_back('\x01');
+
+    // malformed files are rejected
+    const std::string malformed[] = {
+        "0: 1\n1: 0 99999999999\n", "3000000000: 0\n", "0: 5\n", "1: 0\n", "0: 1\n1:\n",
+        std::string("FGB1\xff\xff\xff\x7f\x00\x00\x00\x00", 12), overflow
+    };
+    for (size_t i = 0; i < sizeof(malformed) / sizeof(malformed[0]); ++i) {
+        {
+            std::ofstream output_stream(path.c_str(), std::ios::out | std::ios::binary);
+            output_stream.write(malformed[i].data(), malformed[i].size());
+        }
+        CsrGraph read;
+        if (read_flip_graph(path, read, threads)) {
+            std::cout << "  malformed file " << i << " was accepted" << std::endl;
+            success = false;
+        }
+    }
+
+    std::remove(path.c_str());
+    return success;
+}
+
+bool test_relabeled_codes() {
+    std::mt19937 random(42);
+    const int steps = 200;
+    const int copies = 5;
+
+    for (int n = min_n; n <= 16; ++n) {
+        // random walk on the flip graph that maintains the fingerprint,
+        // which is computed from scratch for the relabeled copies
+        Triangulation triangulation(n);
+        triangulation.set_fingerprinted(true);
+        for (int step = 0; step < steps; ++step) {
+            Code code(triangulation);
+            for (int copy = 0; copy < copies; ++copy) {
+                Triangulation relabeled(random_code(triangulation, random));
+                if (Code(relabeled) != code || relabeled.fingerprint() != triangulation.fingerprint()) {
+                    std::cout << "  n = " << n << ", step " << step << ": relabeled copy differs" << std::endl;
+                    return false;
+                }
+            }
+
+            Edge* edge = triangulation.edge((int) (random() % triangulation.size()));
+            if (triangulation.is_flippable(edge)) { triangulation.flip(edge); }
+        }
+    }
+    return true;
+}
+
+/* ---------------------------------------------------------------------- *
+ * test runner
+ * ---------------------------------------------------------------------- */
+
+struct Test {
+    // the name of the test
+    std::string name;
+
+    // the time budget in seconds
+    double budget;
+
+    // the test, which returns whether it succeeded
+    std::function<bool()> run;
+};
+
+int main(int argc, char* argv[]) {
+    // option -b: factor applied to all time budgets
+    char* option_b = get_cmd_option(argc, argv, "-b");
+    double factor = (option_b) ? std::stod(option_b) : 1.0;
+
+    // option -t: number of threads of the parallel engines
+    char* option_t = get_cmd_option(argc, argv, "-t");
+    if (option_t) { threads = std::stoi(option_t); }
+
+    // the budgets are about three times the time on a single core
+    std::vector<Test> tests;
+    tests.push_back({"generic engine counts", 6.0, test_generic_counts});
+    tests.push_back({"fixed engine", 3.0, test_fixed_engine});
+    tests.push_back({"parallel engine", 6.0, test_parallel_engine});
+    tests.push_back({"sharded engine", 6.0, test_sharded_engine});
+    tests.push_back({"recorded codes", 1.0, test_recorded_codes});
+    tests.push_back({"statistics", 8.0, test_statistics});
+    tests.push_back({"reference values of n = 12", 10.0, test_reference_12});
+    tests.push_back({"restricted classes", 15.0, test_restricted_classes});
+    tests.push_back({"reader", 1.0, test_reader});
+    tests.push_back({"labeled flip graph", 2.0, test_labeled_flip_graph});
+    tests.push_back({"labeled codes", 1.0, test_labeled_codes});
+    tests.push_back({"relabeled codes", 2.0, test_relabeled_codes});
+
+    int failures = 0;
+    for (size_t i = 0; i < tests.size(); ++i) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        bool success = tests[i].run();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        double budget = factor * tests[i].budget;
+        if (success && elapsed.count() > budget) {
+            std::cout << "  took " << elapsed.count() << " s, budget " << budget << " s" << std::endl;
+            success = false;
+        }
+        if (!success) { failures++; }
+        std::cout << (success ? "ok     " : "FAILED ") << tests[i].name << " (" << elapsed.count() << " s)"
+                  << std::endl;
+    }
+
+    std::cout << tests.size() - failures << " of " << tests.size() << " tests passed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */